@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+
+#include "arena.hpp"
+
+// keep in line with arena_owner
+static const char *const owner_names[ARENA_OWNERS] = {"midi", "percussion", "trace", "recorder", "attack cache", "effects"};
+
+static uint8_t *arena = nullptr;
+static uint32_t arena_bytes = 0;
+static uint32_t budget[ARENA_OWNERS];     // bytes of each subsystem
+static uint32_t base[ARENA_OWNERS];       // offset of each budget in the arena
+static uint32_t used[ARENA_OWNERS];       // bytes taken from each budget so far
+
+// memory map of the pico SDK linker script
+extern "C" {
+  extern char __bss_end__[];              // end of the static data
+  extern char __end__[];                  // start of the heap
+  extern char __StackLimit[];             // end of the heap
+  extern char __StackBottom[], __StackTop[];        // stack of core 0
+  extern char __StackOneBottom[], __StackOneTop[];  // stack of core 1
+}
+
+
+void arena_init(uint8_t *ram, const uint32_t (&budgets)[ARENA_OWNERS]) {
+  arena = ram;
+  arena_bytes = 0;
+  for(int i = 0; i < ARENA_OWNERS; i++) {
+    budget[i] = arena_size(budgets[i]);
+    base[i] = arena_bytes;
+    used[i] = 0;
+    arena_bytes += budget[i];
+  }
+}
+
+
+void *arena_take(enum arena_owner owner, uint32_t bytes) {
+  bytes = arena_size(bytes);
+  if(bytes == 0) return nullptr;
+  if(used[owner] + bytes > budget[owner]) {
+    panic("Arena: %s takes %lu bytes, over its budget of %lu bytes\n", owner_names[owner],
+      (unsigned long) (used[owner] + bytes), (unsigned long) budget[owner]);
+  }
+  uint8_t *buffer = &arena[base[owner] + used[owner]];
+  used[owner] += bytes;
+  return buffer;
+}
+
+
+void arena_report(void) {
+  uint32_t heap = uint32_t((char *) sbrk(0) - __end__);
+
+  printf("RAM: static %lu bytes (arena %lu), heap %lu bytes used of %lu, stacks %lu + %lu bytes\r\n",
+    (unsigned long) (__bss_end__ - (char *) SRAM_BASE), (unsigned long) arena_bytes,
+    (unsigned long) heap, (unsigned long) (__StackLimit - __end__),
+    (unsigned long) (__StackTop - __StackBottom), (unsigned long) (__StackOneTop - __StackOneBottom));
+  for(int i = 0; i < ARENA_OWNERS; i++) {
+    if(budget[i] == 0) continue;
+    printf("  %-14s %6lu bytes used of %6lu\r\n", owner_names[i], (unsigned long) used[i], (unsigned long) budget[i]);
+  }
+}
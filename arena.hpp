@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+// startup arena: RAM of the runtime buffers, given out once at boot
+//
+// Buffers whose size depends on the build (midi queues, percussion one-shots, trace ring, recorder log,
+// attack cache, effect delay lines) are not static arrays of their own: each subsystem takes them from its
+// budget in a single arena, when it is initialised, and never gives them back. The budget of each subsystem
+// is declared by the application at build time (see arena_init), from the settings of the subsystem: its
+// header gives its budget in bytes, which is 0 when the subsystem is compiled out, so that a feature costs
+// no RAM unless it is built. Taking more than its budget is a bug of the subsystem, caught at boot.
+//
+// arena_report() prints the RAM map at boot: static data, the arena with the budget and use of each
+// subsystem, the heap (audio buffer pool, usb stack) and the stacks.
+
+#define ARENA_ALIGN         8     // alignment of the buffers taken
+
+// subsystems with a budget in the arena
+enum arena_owner : uint8_t {
+  ARENA_MIDI,                     // midi receive buffer, send queues of the devices
+  ARENA_PERCUSSION,               // percussion one-shots of the synth
+  ARENA_TRACE,                    // trace ring
+  ARENA_RECORDER,                 // show recorder log
+  ARENA_ATTACK_CACHE,             // shadow voices and cached audio
+  ARENA_FX,                       // delay lines and buffers of the effect bus
+  ARENA_OWNERS
+};
+
+// bytes taken from a budget by a buffer of the given size
+constexpr uint32_t arena_size(uint32_t bytes) {
+  return (bytes + ARENA_ALIGN - 1) & ~uint32_t(ARENA_ALIGN - 1);
+}
+
+// size of the arena for the budgets of all the subsystems
+constexpr uint32_t arena_total(const uint32_t (&budgets)[ARENA_OWNERS]) {
+  uint32_t total = 0;
+  for(int i = 0; i < ARENA_OWNERS; i++) total += arena_size(budgets[i]);
+  return total;
+}
+
+// set up the arena over ram (arena_total(budgets) bytes, aligned on ARENA_ALIGN, zeroed), with the budget
+// of each subsystem; to be called first thing at boot, before any subsystem is initialised
+void arena_init(uint8_t *ram, const uint32_t (&budgets)[ARENA_OWNERS]);
+
+// take a buffer of the given size (zeroed, aligned on ARENA_ALIGN) from the budget of a subsystem;
+// nullptr if bytes is 0. Panics if the budget is exceeded
+void *arena_take(enum arena_owner owner, uint32_t bytes);
+
+// print the RAM map over stdio
+void arena_report(void);
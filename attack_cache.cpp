@@ -0,0 +1,151 @@
+#include <string.h>
+#include <new>
+
+#include "attack_cache.hpp"
+
+#if ATTACK_CACHE_MS
+
+static_assert((ATTACK_FADE & (ATTACK_FADE - 1)) == 0, "attack fade must be a power of 2");
+static_assert(ATTACK_CACHE_FRAMES >= 2 * ATTACK_FADE, "attack cache is too short for the crossfade");
+
+enum cache_state : uint8_t {
+  CACHE_EMPTY,                    // no step armed
+  CACHE_FILLING,                  // shadow voices set up, cache being rendered
+  CACHE_READY,                    // cache completely rendered, waiting to be played
+  CACHE_PLAYING,                  // cache played; live voices are faded out over its first frames
+  CACHE_LEAVING                   // shadow voices are live again; rest of the cache is faded out
+};
+
+static synth::AudioChannel *shadow = nullptr;   // CHANNEL_COUNT voices
+static synth::Limiter shadow_limiter;
+static int16_t *cache = nullptr;                // ATTACK_CACHE_FRAMES * output_channels samples
+static int16_t *cache_send = nullptr;           // send mix of the cached audio, ATTACK_CACHE_FRAMES samples
+static cache_state state = CACHE_EMPTY;
+static uint32_t rendered = 0;     // frames of the cache rendered so far
+static uint32_t played = 0;       // frames of the cache played so far
+static uint32_t fade_from = 0;    // frame of the cache at which the current crossfade started
+
+
+void attack_cache_init(void) {
+  shadow = (synth::AudioChannel *) arena_take(ARENA_ATTACK_CACHE, CHANNEL_COUNT * sizeof(synth::AudioChannel));
+  for(int c = 0; c < CHANNEL_COUNT; c++) new (&shadow[c]) synth::AudioChannel();
+  cache = (int16_t *) arena_take(ARENA_ATTACK_CACHE, ATTACK_CACHE_FRAMES * synth::output_channels * sizeof(int16_t));
+  cache_send = (int16_t *) arena_take(ARENA_ATTACK_CACHE, ATTACK_CACHE_FRAMES * sizeof(int16_t));
+}
+
+
+// shadow voices replace the live voices
+static void commit(void) {
+  for(int c = 0; c < CHANNEL_COUNT; c++) synth::channels[c] = shadow[c];
+  synth::limiter = shadow_limiter;
+}
+
+
+synth::AudioChannel *attack_cache_arm(void) {
+  // cache audio is still needed
+  if((state == CACHE_PLAYING) || (state == CACHE_LEAVING)) return nullptr;
+
+  // same instruments, volumes and pans as the live voices, but nothing playing
+  for(int c = 0; c < CHANNEL_COUNT; c++) {
+    shadow[c] = synth::channels[c];
+    shadow[c].adsr = 0;
+    shadow[c].off();
+  }
+  // the cache starts from silence: nothing delayed, no gain reduction
+  shadow_limiter = synth::Limiter();
+  rendered = 0;
+  state = CACHE_FILLING;
+  return shadow;
+}
+
+
+bool attack_cache_render(void) {
+  if(state != CACHE_FILLING) return false;
+
+  uint32_t n = ATTACK_CACHE_FRAMES - rendered;
+  if(n > SYNTH_BLOCK) n = SYNTH_BLOCK;
+  synth::Engine::render(shadow, shadow_limiter, &cache[rendered * synth::output_channels], &cache_send[rendered], n);
+  rendered += n;
+  if(rendered == ATTACK_CACHE_FRAMES) state = CACHE_READY;
+  return true;
+}
+
+
+bool attack_cache_play(void) {
+  if(state != CACHE_READY) return false;
+  played = 0;
+  fade_from = 0;
+  state = CACHE_PLAYING;
+  return true;
+}
+
+
+void attack_cache_stop(void) {
+  if(state != CACHE_PLAYING) return;
+  // shadow voices are ahead of the audio played so far by the rest of the cache
+  commit();
+  fade_from = played;
+  state = CACHE_LEAVING;
+}
+
+
+void attack_cache_clear(void) {
+  state = CACHE_EMPTY;
+}
+
+
+void attack_cache_audio(int16_t *out, int16_t *send, uint32_t count) {
+  int16_t live[SYNTH_BLOCK * synth::output_channels];
+  int16_t live_send[SYNTH_BLOCK];
+
+  while(count) {
+    uint32_t n = (count < SYNTH_BLOCK) ? count : SYNTH_BLOCK;
+
+    // end of the cache: shadow voices are exactly where the cached audio ends
+    if((state == CACHE_PLAYING) && (played == ATTACK_CACHE_FRAMES)) {
+      commit();
+      state = CACHE_EMPTY;
+    }
+    if((state == CACHE_LEAVING) && ((played == ATTACK_CACHE_FRAMES) || (played - fade_from >= ATTACK_FADE))) {
+      state = CACHE_EMPTY;
+    }
+
+    if((state != CACHE_PLAYING) && (state != CACHE_LEAVING)) {
+      synth::render(out, send, n);
+    }
+    else {
+      const int16_t *cached = &cache[played * synth::output_channels];
+      const int16_t *cached_send = &cache_send[played];
+      uint32_t fade_end = fade_from + ATTACK_FADE;
+
+      if(n > ATTACK_CACHE_FRAMES - played) n = ATTACK_CACHE_FRAMES - played;
+      if(played < fade_end) {
+        // crossfade: live audio fades out into the cache when playing, the cache fades out into live audio when leaving
+        if(n > fade_end - played) n = fade_end - played;
+        synth::render(live, live_send, n);
+        const int16_t *from = (state == CACHE_PLAYING) ? live : cached;
+        const int16_t *to = (state == CACHE_PLAYING) ? cached : live;
+        const int16_t *from_send = (state == CACHE_PLAYING) ? live_send : cached_send;
+        const int16_t *to_send = (state == CACHE_PLAYING) ? cached_send : live_send;
+        for(uint32_t i = 0; i < n; i++) {
+          int32_t weight = int32_t(played + i - fade_from);
+          for(uint32_t s = i * synth::output_channels; s < (i + 1) * synth::output_channels; s++) {
+            out[s] = int16_t(((int32_t(to[s]) * weight) + (int32_t(from[s]) * (ATTACK_FADE - weight))) / ATTACK_FADE);
+          }
+          send[i] = int16_t(((int32_t(to_send[i]) * weight) + (int32_t(from_send[i]) * (ATTACK_FADE - weight))) / ATTACK_FADE);
+        }
+      }
+      else {
+        memcpy(out, cached, n * synth::output_channels * sizeof(int16_t));
+        memcpy(send, cached_send, n * sizeof(int16_t));
+      }
+      played += n;
+    }
+
+    out += n * synth::output_channels;
+    send += n;
+    count -= n;
+  }
+}
+
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include "synth.hpp"
+#include "arena.hpp"
+
+// attack cache: the first ATTACK_CACHE_MS of the next step, rendered in advance
+//
+// The next step is known as soon as the current one is played. Its notes are set on shadow voices,
+// and the start of their attack is rendered into the cache during idle time, a block at a time.
+// When the step is played, audio buffers are filled from the cache instead of being rendered: the sound
+// of the previous step is crossfaded into the cached audio over ATTACK_FADE frames, and at the end of
+// the cache the shadow voices, which are exactly at that point, replace the live voices.
+// Press-to-sound latency is then the audio queue alone, whatever the render time of the voices.
+//
+// The send mix of the cached audio is cached along with it, so that the effect bus goes on as if it were rendered.
+//
+// The cache is opt-in: its length is set at build time by ATTACK_CACHE_MS (ATTACK_CACHE CMake option);
+// 0 disables it, and the functions below then cost nothing, nor does it take any RAM in the arena.
+
+#ifndef ATTACK_CACHE_MS
+#define ATTACK_CACHE_MS 0
+#endif
+
+#define ATTACK_CACHE_FRAMES ((ATTACK_CACHE_MS * synth::sample_rate) / 1000)
+#define ATTACK_FADE         64    // frames of crossfade between live and cached audio; must be a power of 2
+
+// RAM of the shadow voices and of the cache in the arena (see arena.hpp)
+#define ATTACK_CACHE_ARENA_BYTES (ATTACK_CACHE_MS ? arena_size(CHANNEL_COUNT * sizeof(synth::AudioChannel)) + \
+  arena_size(ATTACK_CACHE_FRAMES * synth::output_channels * sizeof(int16_t)) + arena_size(ATTACK_CACHE_FRAMES * sizeof(int16_t)) : 0)
+
+#if ATTACK_CACHE_MS
+
+// take the shadow voices and the cache from the arena
+void attack_cache_init(void);
+
+// set up the shadow voices from the live ones, all off, for a new step: notes of the step are then
+// set and triggered on the returned voices. Returns nullptr while the cache is being played.
+synth::AudioChannel *attack_cache_arm(void);
+
+// render the next block of the cache; returns false if there is nothing to render
+bool attack_cache_render(void);
+
+// play the cache from the next audio frame on; returns false if the cache is not completely rendered
+bool attack_cache_play(void);
+
+// stop playing the cache before its end, eg. because the step is released: the shadow voices
+// become the live voices at once, and the rest of the cache is faded out
+void attack_cache_stop(void);
+
+// drop the cache at once, even while it is played, eg. because the voices are reset
+void attack_cache_clear(void);
+
+// audio callback: renders count frames of the live voices and their send mix, or takes them from the cache while it is played
+void attack_cache_audio(int16_t *out, int16_t *send, uint32_t count);
+
+#else
+
+static inline void attack_cache_init(void) {}
+static inline synth::AudioChannel *attack_cache_arm(void) { return nullptr; }
+static inline bool attack_cache_render(void) { return false; }
+static inline bool attack_cache_play(void) { return false; }
+static inline void attack_cache_stop(void) {}
+static inline void attack_cache_clear(void) {}
+static inline void attack_cache_audio(int16_t *out, int16_t *send, uint32_t count) { synth::render(out, send, count); }
+
+#endif
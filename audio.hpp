@@ -5,27 +5,40 @@
  */
 #pragma once
 #include "pico/audio_i2s.h"
+#include "synth.hpp"
+#include "trace.hpp"
 
 #define SAMPLES_PER_BUFFER 256
+#define AUDIO_BUFFERS 3
 
 
-typedef int16_t (*buffer_callback)(void);
+// render time of the audio buffers, for the cpu load meter
+struct audio_load {
+  uint32_t period_us = 0;         // duration of a buffer
+  uint32_t last_us = 0;           // render time of the last buffer
+  uint32_t peak_us = 0;           // longest render time since last reset
+  uint64_t total_us = 0;          // render time since last reset, for the average
+  uint32_t buffers = 0;           // number of buffers rendered since last reset
+};
+
+// count is a number of frames: samples are interleaved left / right in stereo
+typedef void (*buffer_callback)(int16_t *samples, uint32_t count);
 
 struct audio_buffer_pool *init_audio(uint32_t sample_rate, uint8_t pin_data, uint8_t pin_bclk, uint8_t pio_sm=0, uint8_t dma_ch=0) {
   static audio_format_t audio_format = {
     .sample_freq = sample_rate,
     .format = AUDIO_BUFFER_FORMAT_PCM_S16,
-    .channel_count = 1,
+    .channel_count = synth::output_channels,
   };
 
   static struct audio_buffer_format producer_format = {
     .format = &audio_format,
-    .sample_stride = 2
+    .sample_stride = 2 * synth::output_channels
   };
 
   struct audio_buffer_pool *producer_pool = audio_new_producer_pool(
     &producer_format,
-    3,
+    AUDIO_BUFFERS,
     SAMPLES_PER_BUFFER
   );
 
@@ -53,12 +66,25 @@ struct audio_buffer_pool *init_audio(uint32_t sample_rate, uint8_t pin_data, uin
   return producer_pool;
 }
 
-void update_buffer(struct audio_buffer_pool *ap, buffer_callback cb) {
-  struct audio_buffer *buffer = take_audio_buffer(ap, true);
+// fill a free audio buffer, if any; does not wait for a buffer to be free
+// render time is added to load, if given
+// returns false if all buffers are already queued for playing
+bool update_buffer(struct audio_buffer_pool *ap, buffer_callback cb, struct audio_load *load = nullptr) {
+  struct audio_buffer *buffer = take_audio_buffer(ap, false);
+  if (buffer == NULL) return false;
+  TRACE(TRACE_BUFFER_TAKE, buffer->max_sample_count, 0);
+  uint32_t start = time_us_32();
   int16_t *samples = (int16_t *) buffer->buffer->bytes;
-  for (uint i = 0; i < buffer->max_sample_count; i++) {
-      samples[i] = cb();
-  }
+  cb(samples, buffer->max_sample_count);
   buffer->sample_count = buffer->max_sample_count;
+  uint32_t render_us = time_us_32() - start;
   give_audio_buffer(ap, buffer);
+  TRACE(TRACE_BUFFER_GIVE, buffer->max_sample_count, render_us);
+  if (load) {
+    load->last_us = render_us;
+    if (render_us > load->peak_us) load->peak_us = render_us;
+    load->total_us += render_us;
+    load->buffers++;
+  }
+  return true;
 }
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/structs/systick.h"
+
+#include "fx.hpp"
+#include "ring.hpp"
+#include "trace.hpp"
+
+#if FX_ENABLED
+
+using namespace synth;
+
+#define FX_SLICE            32    // frames processed between two checks of the budget
+#define FX_CHORUS_DELAY     7     // chorus delay (ms), modulated by up to FX_CHORUS_DEPTH (ms)
+#define FX_CHORUS_DEPTH     4
+#define FX_CHORUS_RATE      6     // chorus modulation rate (0.1 Hz)
+
+static_assert(((FX_CHORUS_DELAY + FX_CHORUS_DEPTH) * sample_rate) / 1000 + 2 < FX_CHORUS_SIZE, "chorus delay line is too short");
+static_assert((FX_CHORUS_SIZE & (FX_CHORUS_SIZE - 1)) == 0, "chorus delay line size must be a power of 2");
+
+// a delay line of the reverb: comb filter with a damped feedback, or allpass filter
+struct fx_line {
+  int16_t *samples;
+  uint32_t frames;
+  uint32_t pos;
+  int32_t filtered;               // low-pass state of the feedback (combs only)
+};
+
+// buffer handed to core 1, and what it did with it
+struct fx_job {
+  uint16_t frames;
+  bool clear;                     // start again from silence
+};
+
+struct fx_result {
+  uint16_t frames;
+  uint16_t done;                  // frames processed within the budget
+  uint32_t cycles;
+};
+
+// state of the bus, owned by core 1
+static int16_t *lines = nullptr;          // fx_lines_frames() samples
+static struct fx_line combs[FX_COMBS];
+static struct fx_line allpasses[FX_SIDES][FX_ALLPASSES];
+static int16_t *chorus = nullptr;         // FX_CHORUS_SIZE samples
+static uint32_t chorus_pos = 0;
+static uint32_t chorus_phase = 0; // modulation phase (Q32)
+
+// buffers exchanged with core 1: owned by core 1 from the job being pushed to the result being pushed
+static int16_t *job_send = nullptr;       // FX_FRAMES samples
+static int16_t *job_return = nullptr;     // FX_FRAMES * output_channels samples
+static spsc_ring<struct fx_job, 2> jobs;          // core 0 to core 1
+static spsc_ring<struct fx_result, 2> results;    // core 1 to core 0
+
+// state and measurements of core 0
+static bool busy = false;         // a job has been handed to core 1, and its result not received yet
+static bool bypassed = false;
+static bool clear = true;         // next job starts from silence
+static uint32_t bypass_end = 0;   // end of the bypass, in usec since boot
+static uint32_t buffers = 0;      // buffers processed, since the last report
+static uint64_t total_cycles = 0;
+static uint32_t max_cycles = 0;
+static uint32_t overruns = 0;     // buffers over budget, since boot
+static uint32_t late = 0;         // buffers whose return was not ready in time, since boot
+static uint32_t quiet_frames = 0; // frames in a row with a silent send and no return
+
+
+static inline int16_t clip(int32_t sample) {
+  return sample <= -0x8000 ? -0x8000 : (sample > 0x7fff ? 0x7fff : sample);
+}
+
+// systick of core 1 as a free running cycle counter, as for the scheduler of core 0
+static inline uint32_t cycles_since(uint32_t start) {
+  return (start - systick_hw->cvr) & 0xffffff;
+}
+
+
+static void clear_lines(void) {
+  int16_t *samples = lines;
+
+  memset(lines, 0, fx_lines_frames() * sizeof(int16_t));
+  memset(chorus, 0, FX_CHORUS_SIZE * sizeof(int16_t));
+  for(int i = 0; i < FX_COMBS; i++) {
+    combs[i] = {samples, fx_comb_frames[i], 0, 0};
+    samples += fx_comb_frames[i];
+  }
+  for(uint32_t s = 0; s < FX_SIDES; s++) {
+    for(int i = 0; i < FX_ALLPASSES; i++) {
+      allpasses[s][i] = {samples, fx_allpass_frames[s][i], 0, 0};
+      samples += fx_allpass_frames[s][i];
+    }
+  }
+}
+
+
+// chorus tap at delay (Q8 frames), linearly interpolated
+static inline int32_t chorus_tap(uint32_t delay) {
+  uint32_t pos = chorus_pos - (delay >> 8);
+  int32_t a = chorus[pos & (FX_CHORUS_SIZE - 1)];
+  int32_t b = chorus[(pos - 1) & (FX_CHORUS_SIZE - 1)];
+  return a + (((b - a) * int32_t(delay & 0xff)) >> 8);
+}
+
+
+// delay (Q8 frames) of a chorus tap for a modulation phase: a triangle around the chorus delay
+static inline uint32_t chorus_delay(uint32_t phase) {
+  constexpr uint32_t base = ((FX_CHORUS_DELAY * sample_rate) / 1000) << 8;
+  constexpr uint32_t depth = ((FX_CHORUS_DEPTH * sample_rate) / 1000) << 8;
+  uint32_t triangle = (phase & 0x80000000) ? (~phase >> 15) : (phase >> 15);   // 0 to 0xffff
+  return base + ((depth * triangle) >> 16);
+}
+
+
+// process n frames of the send mix into the return
+static void process(const int16_t *send, int16_t *out, uint32_t n) {
+  constexpr uint32_t rate = uint32_t((uint64_t(FX_CHORUS_RATE) << 32) / (10 * sample_rate));
+
+  for(uint32_t i = 0; i < n; i++) {
+    int32_t in = send[i];
+
+    // chorus: two taps in opposite phases, one per side
+    chorus[chorus_pos & (FX_CHORUS_SIZE - 1)] = int16_t(in);
+    int32_t chorus_left = chorus_tap(chorus_delay(chorus_phase));
+    int32_t chorus_right = chorus_tap(chorus_delay(chorus_phase + 0x80000000));
+    chorus_pos++;
+    chorus_phase += rate;
+
+    // reverb: parallel combs, each with a low-pass in its feedback; the feedback paths divide rather than shift,
+    // rounding towards 0, so that the tail dies out to silence instead of settling on a small offset
+    int32_t input = in >> 3;
+    int32_t reverb = 0;
+    for(int c = 0; c < FX_COMBS; c++) {
+      struct fx_line *comb = &combs[c];
+      int32_t delayed = comb->samples[comb->pos];
+      comb->filtered = delayed + (((comb->filtered - delayed) * FX_DAMP) / 0x8000);
+      comb->samples[comb->pos] = clip(input + ((comb->filtered * FX_ROOM) / 0x8000));
+      if(++comb->pos == comb->frames) comb->pos = 0;
+      reverb += delayed;
+    }
+    reverb >>= 2;
+
+    // then allpasses in series, a chain of its own for each side, so that sides are not correlated
+    for(uint32_t s = 0; s < FX_SIDES; s++) {
+      int32_t sample = reverb;
+      for(int a = 0; a < FX_ALLPASSES; a++) {
+        struct fx_line *allpass = &allpasses[s][a];
+        int32_t delayed = allpass->samples[allpass->pos];
+        allpass->samples[allpass->pos] = clip(sample + (delayed / 2));
+        if(++allpass->pos == allpass->frames) allpass->pos = 0;
+        sample = delayed - sample;
+      }
+      int32_t chorused = (output_channels == 2) ? (s ? chorus_right : chorus_left) : ((chorus_left + chorus_right) >> 1);
+      out[(i * output_channels) + s] = clip(((chorused * FX_CHORUS) >> 15) + ((sample * FX_REVERB) >> 15));
+    }
+  }
+}
+
+
+// core 1: process the jobs as they come, each within the budget
+static void fx_core(void) {
+  struct fx_job job;
+
+  // flash writes of core 0 hold this core (see flash_write_begin)
+  multicore_lockout_victim_init();
+
+  // systick: processor clock, no interrupt, full 24 bit range
+  systick_hw->rvr = 0xffffff;
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5;
+
+  while(true) {
+    if(!jobs.pop(job)) {
+      __wfe();
+      continue;
+    }
+    if(job.clear) clear_lines();
+
+    uint32_t budget = uint32_t((uint64_t(job.frames) * SYS_CLK_KHZ * 10 * FX_BUDGET_PERCENT) / sample_rate);
+    uint32_t start = systick_hw->cvr;
+    uint32_t done = 0;
+    while((done < job.frames) && (cycles_since(start) < budget)) {
+      uint32_t n = (job.frames - done < FX_SLICE) ? job.frames - done : FX_SLICE;
+      process(&job_send[done], &job_return[done * output_channels], n);
+      done += n;
+    }
+    results.push({job.frames, uint16_t(done), cycles_since(start)});
+  }
+}
+
+
+void fx_init(void) {
+  lines = (int16_t *) arena_take(ARENA_FX, fx_lines_frames() * sizeof(int16_t));
+  chorus = (int16_t *) arena_take(ARENA_FX, FX_CHORUS_SIZE * sizeof(int16_t));
+  job_send = (int16_t *) arena_take(ARENA_FX, FX_FRAMES * sizeof(int16_t));
+  job_return = (int16_t *) arena_take(ARENA_FX, FX_FRAMES * output_channels * sizeof(int16_t));
+  multicore_launch_core1(fx_core);
+}
+
+
+static void bypass(uint32_t done, uint32_t cycles) {
+  (void) done;
+  (void) cycles;
+  TRACE(TRACE_FX, done, cycles);
+  bypassed = true;
+  bypass_end = time_us_32() + (FX_BYPASS_MS * 1000);
+}
+
+
+// add the return of n frames to out; faded out over these frames if the rest of the return is missing.
+// Returns false if the return is silent
+static bool add_return(int16_t *out, uint32_t n, bool fade) {
+  int32_t any = 0;
+
+  if(!fade) {
+    for(uint32_t i = 0; i < n * output_channels; i++) {
+      any |= job_return[i];
+      out[i] = clip(out[i] + job_return[i]);
+    }
+    return any != 0;
+  }
+  int32_t gain = 0x10000;
+  int32_t step = n ? 0x10000 / int32_t(n) : 0;
+  for(uint32_t i = 0; i < n; i++) {
+    gain -= step;
+    for(uint32_t s = i * output_channels; s < (i + 1) * output_channels; s++) {
+      any |= job_return[s];
+      out[s] = clip(out[s] + ((job_return[s] * gain) >> 16));
+    }
+  }
+  return any != 0;
+}
+
+
+// count the frames in a row without any sound going through the bus
+static void count_quiet(const int16_t *send, uint32_t count, bool returned) {
+  int32_t any = returned;
+  for(uint32_t i = 0; i < count; i++) any |= send[i];
+  if(any) quiet_frames = 0;
+  else if(quiet_frames < 0x80000000) quiet_frames += count;
+}
+
+
+void fx_audio(int16_t *out, const int16_t *send, uint32_t count) {
+  struct fx_result result;
+
+  if(count > FX_FRAMES) count = FX_FRAMES;
+
+  if(busy) {
+    if(!results.pop(result)) {
+      // core 1 is still on the previous buffer, eg. because two buffers were rendered back to back, or core 1
+      // was held by a flash write: no return for this buffer, and its send is dropped; the job stays in flight,
+      // and its return is added to the buffer it is ready for
+      late++;
+      count_quiet(send, count, false);
+      return;
+    }
+    busy = false;
+    buffers++;
+    total_cycles += result.cycles;
+    if(result.cycles > max_cycles) max_cycles = result.cycles;
+
+    // return of the previous buffer; when the budget was exceeded, what was processed is faded out
+    bool over = (result.done < result.frames);
+    bool returned = false;
+    if(over) overruns++;
+    if(!bypassed) returned = add_return(out, (result.done < count) ? result.done : count, over);
+    if(over && !bypassed) bypass(result.done, result.cycles);
+    count_quiet(send, count, returned);
+  }
+  else count_quiet(send, count, false);
+
+  if(bypassed) {
+    if(int32_t(time_us_32() - bypass_end) < 0) return;
+    bypassed = false;
+    clear = true;
+  }
+
+  memcpy(job_send, send, count * sizeof(int16_t));
+  jobs.push({uint16_t(count), clear});
+  __sev();
+  clear = false;
+  busy = true;
+}
+
+
+bool fx_silent(void) {
+  // a sound sent to the bus dies out within the length of all its delay lines
+  return bypassed || (quiet_frames >= fx_lines_frames() + FX_CHORUS_SIZE);
+}
+
+
+void fx_report(void) {
+  uint32_t budget = uint32_t((uint64_t(FX_FRAMES) * SYS_CLK_KHZ * 10 * FX_BUDGET_PERCENT) / sample_rate);
+  uint32_t average = buffers ? uint32_t(total_cycles / buffers) : 0;
+
+  printf("Effects on core 1: %lu buffers, average %lu cyc, peak %lu cyc, budget %lu cyc for %d frames, overruns %lu, late %lu%s\r\n",
+    (unsigned long) buffers, (unsigned long) average, (unsigned long) max_cycles, (unsigned long) budget, FX_FRAMES,
+    (unsigned long) overruns, (unsigned long) late, bypassed ? ", bypassed" : "");
+  buffers = 0;
+  total_cycles = 0;
+  max_cycles = 0;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include "synth.hpp"
+#include "arena.hpp"
+
+// effect bus: a chorus and a reverb shared by all the voices, run on core 1
+//
+// Each voice sends a part of its sound (its send level, see presets) to a single mono send mix, rendered
+// along with the voices. At each audio buffer, the send mix goes to core 1, which has nothing else to do:
+// it runs the chorus (two taps of a modulated delay line, one per side) and the reverb (comb filters with
+// damping, then a chain of allpass filters per side) while core 0 goes on, and the return of the bus is added
+// to the next audio buffer. The return is thus late by a buffer, which makes the pre-delay of the reverb.
+// One bus for all the voices keeps the cost of the effects the same whatever the number of voices playing.
+//
+// Core 1 has a hard budget of FX_BUDGET_PERCENT of the duration of a buffer, in cpu cycles: when it is spent,
+// processing stops where it is, the return fades out, and the bus is bypassed for FX_BYPASS_MS before it starts
+// again from silence. A return which is not ready when the next buffer is (core 0 rendering buffers back to back,
+// core 1 held by a flash write) is not an overrun: that buffer goes without a return, and the return is added
+// to the buffer it is ready for.
+//
+// The return is added after the master limiter, at levels which leave it well under the headroom of the limiter
+// knee (FX_CHORUS, FX_REVERB); the sum is clipped.
+//
+// The delay lines and the buffers exchanged with core 1 are taken from the arena (see arena.hpp).
+// The bus is compiled in with FX_ENABLED (FX CMake option): without it, the functions below cost nothing,
+// the bus takes no RAM, and presets send nothing, so that voices do not render a send mix for nothing.
+
+#ifndef FX_ENABLED
+#define FX_ENABLED 0
+#endif
+
+#define FX_FRAMES           256   // largest audio buffer, in frames
+#define FX_BUDGET_PERCENT   50    // cycles of core 1 for a buffer, in % of its duration
+#define FX_BYPASS_MS        1000  // bypass time after the budget has been exceeded
+
+#define FX_CHORUS           0x2000    // return levels (Q15)
+#define FX_REVERB           0x3000
+#define FX_ROOM             0x6b85    // feedback of the reverb combs (Q15): length of the reverb tail
+#define FX_DAMP             0x3333    // damping of the reverb combs (Q15): high frequencies die out faster
+
+#define FX_COMBS            4
+#define FX_ALLPASSES        2
+#define FX_SIDES            synth::output_channels    // allpass chains: one per side
+#define FX_CHORUS_SIZE      1024  // chorus delay line, in frames; must be a power of 2
+
+// delay line lengths are the Freeverb tunings at 44.1 kHz, scaled to the sample rate
+constexpr uint32_t fx_line_frames(uint32_t frames) {
+  return (frames * synth::sample_rate) / 44100;
+}
+
+constexpr uint32_t fx_comb_frames[FX_COMBS] = {fx_line_frames(1116), fx_line_frames(1188), fx_line_frames(1277), fx_line_frames(1356)};
+constexpr uint32_t fx_allpass_frames[2][FX_ALLPASSES] = {{fx_line_frames(556), fx_line_frames(441)}, {fx_line_frames(579), fx_line_frames(464)}};
+
+// frames of all the reverb delay lines
+constexpr uint32_t fx_lines_frames() {
+  uint32_t frames = 0;
+  for(int i = 0; i < FX_COMBS; i++) frames += fx_comb_frames[i];
+  for(uint32_t s = 0; s < FX_SIDES; s++) {
+    for(int i = 0; i < FX_ALLPASSES; i++) frames += fx_allpass_frames[s][i];
+  }
+  return frames;
+}
+
+// RAM of the bus in the arena: reverb and chorus delay lines, send and return buffers of core 1
+#define FX_ARENA_BYTES (FX_ENABLED ? arena_size(fx_lines_frames() * sizeof(int16_t)) + arena_size(FX_CHORUS_SIZE * sizeof(int16_t)) + \
+  arena_size(FX_FRAMES * sizeof(int16_t)) + arena_size(FX_FRAMES * synth::output_channels * sizeof(int16_t)) : 0)
+
+#if FX_ENABLED
+
+// take the buffers of the bus from the arena, and start it on core 1
+void fx_init(void);
+
+// audio callback: add the return of the previous buffer to out (count frames), and hand the send mix
+// of this one (count mono samples) to core 1; count <= FX_FRAMES
+void fx_audio(int16_t *out, const int16_t *send, uint32_t count);
+
+// true if no sound goes through the bus: nothing sent, and the reverb tail has died out
+bool fx_silent(void);
+
+// print the cycles used by the bus and the number of bypasses over stdio, since the last report
+void fx_report(void);
+
+#else
+
+static inline void fx_init(void) {}
+static inline void fx_audio(int16_t *out, const int16_t *send, uint32_t count) { (void) out; (void) send; (void) count; }
+static inline bool fx_silent(void) { return true; }
+static inline void fx_report(void) {}
+
+#endif
@@ -0,0 +1,131 @@
+#include "pico/stdlib.h"
+
+#include "midi_clock.hpp"
+#include "synth.hpp"
+
+// loop gains, as shifts: each tick moves the phase by 1/4 and the period by 1/64 of its error
+#define PHASE_SHIFT         2
+#define PERIOD_SHIFT        6
+#define RENDER_SHIFT        4     // render time base: 1/16 of its error per block
+#define RENDER_RESYNC_US    20000 // render time base is set again after such a gap (underrun, stall)
+
+static bool running = false;      // clock started, and not stopped
+static int ticks_per_step = 0;    // 0 if steps are not driven by the clock
+static uint32_t ticks = 0;        // ticks received since start
+static uint32_t next_step = 0;    // tick of the next step
+static uint32_t phase_us = 0;     // filtered time of the last tick
+static uint32_t phase_frac = 0;   // fraction of phase_us (Q8)
+static uint32_t period_q8 = 0;    // filtered tick period in usec (Q8); 0 until two ticks have been received
+static uint32_t last_us = 0;      // time of the last tick, as received
+
+static bool render_synced = false;
+static uint32_t render_us = 0;    // filtered time at which the current block is rendered
+
+
+void clock_start(uint32_t time_us) {
+  (void) time_us;
+  running = true;
+  ticks = 0;
+  next_step = 0;
+}
+
+
+void clock_continue(uint32_t time_us) {
+  (void) time_us;
+  running = true;
+}
+
+
+void clock_stop(void) {
+  running = false;
+}
+
+
+void clock_tick(uint32_t time_us) {
+  if(ticks == 0) {
+    // first tick: nothing to predict from
+    phase_us = time_us;
+    phase_frac = 0;
+  }
+  else if((period_q8 != 0) && ((time_us - last_us) > (period_q8 >> 6))) {
+    // no tick for more than 4 periods: the clock was lost, the phase starts again from this tick
+    phase_us = time_us;
+    phase_frac = 0;
+  }
+  else if(period_q8 == 0) {
+    // second tick: first period
+    period_q8 = (time_us - last_us) << 8;
+    phase_us = time_us;
+  }
+  else {
+    // delay-locked loop: the phase follows the ticks, the period follows the drift of the phase;
+    // a tick far from where it is expected (lost or delayed usb data, tempo change) is only partly followed
+    uint32_t predicted = phase_us + ((period_q8 + phase_frac) >> 8);
+    phase_frac = (period_q8 + phase_frac) & 0xff;
+    int32_t error = int32_t(time_us - predicted);
+    int32_t limit = int32_t(period_q8 >> 9);
+    if(error > limit) error = limit;
+    if(error < -limit) error = -limit;
+    phase_us = predicted + (error >> PHASE_SHIFT);
+    period_q8 += (error << 8) >> PERIOD_SHIFT;
+  }
+  last_us = time_us;
+  ticks++;
+}
+
+
+void clock_steps(int steps_per_bar) {
+  if((steps_per_bar <= 0) || (steps_per_bar > CLOCK_TICKS_PER_BAR) || (CLOCK_TICKS_PER_BAR % steps_per_bar)) {
+    ticks_per_step = 0;
+    return;
+  }
+  ticks_per_step = CLOCK_TICKS_PER_BAR / steps_per_bar;
+  // same grid from the start of the clock, whatever the song
+  next_step = ((ticks + ticks_per_step - 1) / ticks_per_step) * ticks_per_step;
+}
+
+
+bool clock_driving(void) {
+  return running && (ticks_per_step != 0);
+}
+
+
+uint32_t clock_tempo(void) {
+  if(period_q8 == 0) return 0;
+  // 60 s per minute, in tenths of bpm
+  return uint32_t((600000000ULL << 8) / (uint64_t(period_q8) * CLOCK_PPQN));
+}
+
+
+int32_t clock_step_frame(uint32_t count) {
+  uint32_t now = time_us_32();
+  uint32_t block_us = uint32_t((uint64_t(count) * 1000000) / synth::sample_rate);
+
+  // render time base: blocks are rendered one after the other, at the sample rate, give or take
+  // the latency of the main loop; filtering it keeps that latency out of the step time
+  if(render_synced) {
+    int32_t error = int32_t(now - render_us);
+    if((error > RENDER_RESYNC_US) || (error < -RENDER_RESYNC_US)) render_us = now;
+    else render_us += error >> RENDER_SHIFT;
+  }
+  else {
+    render_us = now;
+    render_synced = true;
+  }
+  uint32_t block_start = render_us;
+  render_us += block_us;
+
+  // step is predicted from the filtered clock phase; it is only predicted a tick ahead, so that
+  // steps stop when the clock is lost without a stop message
+  if(!clock_driving() || (ticks == 0)) return -1;
+  // steps missed by more than a tick (eg. the clock was lost) are dropped rather than played in a burst
+  while(int32_t(next_step - (ticks - 1)) < 0) next_step += ticks_per_step;
+  if(next_step > ticks) return -1;
+  int32_t ahead = int32_t(next_step - (ticks - 1));          // ticks from the last tick to the step: 0 or 1
+  int32_t step_us = int32_t(phase_us - block_start) + int32_t((int64_t(ahead) * period_q8) >> 8);
+  if(step_us >= int32_t(block_us)) return -1;
+
+  next_step += ticks_per_step;
+  if(step_us <= 0) return 0;
+  return int32_t((uint64_t(step_us) * synth::sample_rate) / 1000000);
+}
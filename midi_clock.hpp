@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+// midi clock follower: steps of the song played on the beat of an external midi clock
+//
+// Clock ticks (0xF8, 24 per quarter note) are received with the jitter of the usb frames and of the main loop.
+// They go through a delay-locked loop which estimates the tick period and phase, so that the time of the
+// next step is predicted from the filtered clock phase, rather than taken from when a tick is seen.
+// The audio side maps that time to a frame of the block being rendered, with a render time base filtered
+// the same way, and the step is triggered at that very frame (see clock_step_frame).
+//
+// Start (0xFA) plays a step on the first tick, then a step every 96 / steps_per_bar ticks (4/4 bars);
+// continue (0xFB) resumes on the same grid, and stop (0xFC) stops playing steps. Songs without a
+// steps-per-bar setting (see songdir.py) are not driven by the clock.
+
+#define CLOCK_PPQN          24    // clock ticks per quarter note
+#define CLOCK_TICKS_PER_BAR (4 * CLOCK_PPQN)
+
+// clock messages; time is the reception time of the message in usec since boot
+void clock_start(uint32_t time_us);
+void clock_continue(uint32_t time_us);
+void clock_stop(void);
+void clock_tick(uint32_t time_us);
+
+// number of steps per bar of the song; 0, or a number which does not divide CLOCK_TICKS_PER_BAR,
+// if steps are not driven by the clock
+void clock_steps(int steps_per_bar);
+
+// true if the clock is running and drives the steps of the song
+bool clock_driving(void);
+
+// tempo estimated from the clock, in tenths of bpm; 0 if unknown
+uint32_t clock_tempo(void);
+
+// audio callback, before rendering a block of count frames: frame of the block at which the next step
+// must be played, or -1 if there is no step in this block. A step returned is considered played
+int32_t clock_step_frame(uint32_t count);
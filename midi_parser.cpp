@@ -0,0 +1,93 @@
+#include "midi_parser.hpp"
+
+// number of data bytes for each channel message, by high nibble (0x80 to 0xE0)
+static const uint8_t channel_length [7] = {2, 2, 2, 2, 1, 1, 2};
+
+// number of data bytes for system common messages, by low nibble (0xF0 to 0xF7); 0xFF: not a system common message
+static const uint8_t common_length [8] = {0xFF, 1, 2, 1, 0xFF, 0xFF, 0, 0xFF};
+
+
+void midi_parser_reset(struct midi_parser *parser) {
+  parser->status = 0;
+  parser->expected = 0;
+  parser->count = 0;
+  parser->in_sysex = false;
+  parser->sysex_overflow = false;
+  parser->sysex_length = 0;
+}
+
+
+midi_parse_result midi_parse_byte(struct midi_parser *parser, uint8_t byte, struct midi_message *msg) {
+
+  // data byte: most frequent case first
+  if(byte < 0x80) {
+    if(parser->in_sysex) {
+      if(parser->sysex_length < MIDI_SYSEX_MAX) parser->sysex[parser->sysex_length++] = byte;
+      else parser->sysex_overflow = true;
+      return MIDI_NONE;
+    }
+
+    // no status to attach the byte to: drop it
+    if(parser->status == 0) return MIDI_NONE;
+
+    parser->data[parser->count++] = byte;
+    if(parser->count < parser->expected) return MIDI_NONE;
+
+    msg->status = parser->status;
+    msg->data[0] = parser->data[0];
+    msg->data[1] = parser->data[1];
+    msg->length = parser->expected;
+
+    // channel messages keep their status for running status; system common messages don't
+    parser->count = 0;
+    if(parser->status >= 0xF0) parser->status = 0;
+    return MIDI_MESSAGE;
+  }
+
+  // real-time message: single byte, may come anywhere, does not change parser state
+  if(byte >= 0xF8) {
+    msg->status = byte;
+    msg->length = 0;
+    return MIDI_MESSAGE;
+  }
+
+  // channel message: this is the new running status
+  if(byte < 0xF0) {
+    parser->in_sysex = false;       // a status byte ends (and drops) any unterminated SysEx
+    parser->status = byte;
+    parser->expected = channel_length[(byte >> 4) - 8];
+    parser->count = 0;
+    return MIDI_NONE;
+  }
+
+  // start of SysEx
+  if(byte == 0xF0) {
+    parser->in_sysex = true;
+    parser->sysex_overflow = false;
+    parser->sysex_length = 0;
+    parser->status = 0;
+    return MIDI_NONE;
+  }
+
+  // end of SysEx
+  if(byte == 0xF7) {
+    if(!parser->in_sysex) return MIDI_NONE;
+    parser->in_sysex = false;
+    return MIDI_SYSEX;
+  }
+
+  // system common message: cancels running status
+  parser->in_sysex = false;
+  parser->status = 0;
+  parser->count = 0;
+  uint8_t length = common_length[byte & 0x07];
+  if(length == 0xFF) return MIDI_NONE;    // undefined (0xF4, 0xF5)
+  if(length == 0) {
+    msg->status = byte;
+    msg->length = 0;
+    return MIDI_MESSAGE;
+  }
+  parser->status = byte;
+  parser->expected = length;
+  return MIDI_NONE;
+}
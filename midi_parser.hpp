@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+// incremental MIDI 1.0 stream parser
+//
+// Bytes are fed one at a time, as they come out of the usb midi stream, so a message may be
+// split across several reads. The parser supports running status, lets real-time bytes
+// (0xF8-0xFF) through at any time, even in the middle of another message or of a SysEx,
+// and collects SysEx messages into a bounded buffer. Data bytes without a status are dropped.
+
+#define MIDI_SYSEX_MAX  128       // max size of a SysEx message, F0 and F7 excluded; longer messages are truncated
+
+enum midi_parse_result {
+  MIDI_NONE,                      // no complete message yet
+  MIDI_MESSAGE,                   // a complete channel, system common or real-time message is available
+  MIDI_SYSEX                      // a complete SysEx message is available in the parser sysex buffer
+};
+
+struct midi_message {
+  uint8_t status;                 // status byte, including channel for channel messages
+  uint8_t data[2];                // data bytes
+  uint8_t length;                 // number of data bytes (0 to 2)
+};
+
+struct midi_parser {
+  uint8_t status = 0;             // status of the message being received; 0 if none (no running status)
+  uint8_t expected = 0;           // number of data bytes of the message being received
+  uint8_t count = 0;              // number of data bytes received so far
+  uint8_t data[2];                // data bytes received so far
+
+  bool in_sysex = false;          // a SysEx message is being received
+  bool sysex_overflow = false;    // SysEx message was longer than MIDI_SYSEX_MAX and has been truncated
+  uint16_t sysex_length = 0;      // number of bytes in sysex
+  uint8_t sysex[MIDI_SYSEX_MAX];  // SysEx data, F0 and F7 excluded
+};
+
+void midi_parser_reset(struct midi_parser *parser);
+midi_parse_result midi_parse_byte(struct midi_parser *parser, uint8_t byte, struct midi_message *msg);
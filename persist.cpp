@@ -0,0 +1,142 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+
+#include "persist.hpp"
+
+// a record is 16 bytes; an erased record reads as all 1s
+struct persist_record {
+  uint32_t sequence;              // increasing at each save; 0xffffffff if record is free
+  uint16_t song_num;
+  uint16_t step;
+  uint16_t instr_offset;
+  uint16_t magic;                 // PERSIST_MAGIC for a valid record
+  uint32_t check;                 // check value of the other fields
+};
+
+#define PERSIST_MAGIC       0x5043
+#define PERSIST_OFFSET      (PICO_FLASH_SIZE_BYTES - (PERSIST_SECTORS * FLASH_SECTOR_SIZE))
+#define RECORDS_PER_SECTOR  (FLASH_SECTOR_SIZE / sizeof(struct persist_record))
+#define PERSIST_RECORDS     (PERSIST_SECTORS * RECORDS_PER_SECTOR)
+#define RECORDS_PER_PAGE    (FLASH_PAGE_SIZE / sizeof(struct persist_record))
+
+static_assert(sizeof(struct persist_record) == 16, "flash record must be 16 bytes");
+
+// position of the next free record, and sequence number of the last saved record
+static uint32_t next_record = 0;
+static uint32_t last_sequence = 0;
+
+
+// records, as seen through the flash memory mapping
+static inline const struct persist_record *record_at(uint32_t index) {
+  return (const struct persist_record *) (XIP_BASE + PERSIST_OFFSET + (index * sizeof(struct persist_record)));
+}
+
+static uint32_t check_of(const struct persist_record *record) {
+  return (record->sequence * 2654435761u) ^ (uint32_t(record->song_num) << 16) ^ (uint32_t(record->step) << 8) ^
+         record->instr_offset ^ (uint32_t(record->magic) << 24);
+}
+
+static bool is_valid(const struct persist_record *record) {
+  return (record->magic == PERSIST_MAGIC) && (record->sequence != 0xffffffff) && (record->check == check_of(record));
+}
+
+static bool is_free(const struct persist_record *record) {
+  const uint32_t *words = (const uint32_t *) record;
+  for(uint32_t i = 0; i < sizeof(struct persist_record) / 4; i++) {
+    if(words[i] != 0xffffffff) return false;
+  }
+  return true;
+}
+
+
+bool persist_restore(struct persist_state *state) {
+  const struct persist_record *last = nullptr;
+  uint32_t last_index = 0;
+
+  // the last saved record is the valid one with the highest sequence number
+  for(uint32_t i = 0; i < PERSIST_RECORDS; i++) {
+    const struct persist_record *record = record_at(i);
+    if(!is_valid(record)) continue;
+    if((last == nullptr) || (int32_t(record->sequence - last->sequence) > 0)) {
+      last = record;
+      last_index = i;
+    }
+  }
+
+  if(last == nullptr) {
+    next_record = 0;
+    last_sequence = 0;
+    return false;
+  }
+
+  // records are written in order: next record is the one following the last saved one
+  next_record = (last_index + 1) % PERSIST_RECORDS;
+  last_sequence = last->sequence;
+  state->song_num = last->song_num;
+  state->step = last->step;
+  state->instr_offset = last->instr_offset;
+  return true;
+}
+
+
+bool persist_save(const struct persist_state *state) {
+  static uint8_t page[FLASH_PAGE_SIZE];
+  struct persist_record record;
+
+  // next record must have been erased (see persist_prepare)
+  if(!is_free(record_at(next_record))) return false;
+
+  record.sequence = last_sequence + 1;
+  if(record.sequence == 0xffffffff) record.sequence = 1;
+  record.song_num = state->song_num;
+  record.step = state->step;
+  record.instr_offset = state->instr_offset;
+  record.magic = PERSIST_MAGIC;
+  record.check = check_of(&record);
+
+  // flash is programmed by pages: other records of the page are left as all 1s, which does not change them
+  memset(page, 0xff, sizeof(page));
+  memcpy(&page[(next_record % RECORDS_PER_PAGE) * sizeof(struct persist_record)], &record, sizeof(record));
+
+  uint32_t interrupts = flash_write_begin();
+  flash_range_program(PERSIST_OFFSET + ((next_record / RECORDS_PER_PAGE) * FLASH_PAGE_SIZE), page, FLASH_PAGE_SIZE);
+  flash_write_end(interrupts);
+
+  last_sequence = record.sequence;
+  next_record = (next_record + 1) % PERSIST_RECORDS;
+  return true;
+}
+
+
+bool persist_prepare(void) {
+  // the sector holding the next record must be erased before it is written to;
+  // erase it as soon as the previous sector starts being used, so that saving never has to wait for an erase
+  uint32_t sector = ((next_record / RECORDS_PER_SECTOR) + ((next_record % RECORDS_PER_SECTOR) ? 1 : 0)) % PERSIST_SECTORS;
+  uint32_t first = sector * RECORDS_PER_SECTOR;
+
+  for(uint32_t i = first; i < first + RECORDS_PER_SECTOR; i++) {
+    if(!is_free(record_at(i))) {
+      uint32_t interrupts = flash_write_begin();
+      flash_range_erase(PERSIST_OFFSET + (sector * FLASH_SECTOR_SIZE), FLASH_SECTOR_SIZE);
+      flash_write_end(interrupts);
+      return true;
+    }
+  }
+  return false;
+}
+
+
+uint32_t flash_write_begin(void) {
+  // core 1 is paused first: it answers from an interrupt handler in RAM
+  if(multicore_lockout_victim_is_initialized(1)) multicore_lockout_start_blocking();
+  return save_and_disable_interrupts();
+}
+
+
+void flash_write_end(uint32_t interrupts) {
+  restore_interrupts(interrupts);
+  if(multicore_lockout_victim_is_initialized(1)) multicore_lockout_end_blocking();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// state kept in flash across power cycles: current song, position in the song and instrument offset
+//
+// The state is written as small records in the last PERSIST_SECTORS sectors of the flash, one after
+// the other, so that a sector is only erased once all its records have been used (wear levelling).
+// At boot, the valid record with the highest sequence number is the last saved state.
+//
+// Programming a record only takes a few hundred usec; erasing a sector takes tens of msec
+// with interrupts and flash access stopped, so persist_prepare() should only be called
+// when no sound is played.
+
+#define PERSIST_SECTORS   2
+
+struct persist_state {
+  uint16_t song_num;              // song number
+  uint16_t step;                  // next step number in the song
+  uint16_t instr_offset;          // instrument offset
+};
+
+// read the last saved state; returns false if no state has been saved yet
+bool persist_restore(struct persist_state *state);
+
+// save a state; returns false if there is no free record, ie. persist_prepare() must be called first
+bool persist_save(const struct persist_state *state);
+
+// make sure the next sector is erased before the current one is full
+// returns true if a sector has been erased
+bool persist_prepare(void);
+
+// flash is not readable while it is erased or programmed, so nothing may run from it meanwhile:
+// interrupts are disabled, and the other core, if it has been started (see fx.hpp), is held in RAM
+// until flash_write_end(). Every erase and program of the flash must be done between the two
+uint32_t flash_write_begin(void);
+void flash_write_end(uint32_t interrupts);
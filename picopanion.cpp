@@ -29,6 +29,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <new>
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "bsp/board_api.h"
@@ -37,16 +38,37 @@
 
 #include "synth.hpp"
 #include "audio.hpp"
-#include "song.h"
+#include "ring.hpp"
+#include "sched.hpp"
+#include "midi_parser.hpp"
+#include "songdata.hpp"
+#include "persist.hpp"
+#include "presets.hpp"
+#include "midi_clock.hpp"
+#include "trace.hpp"
+#include "attack_cache.hpp"
+#include "recorder.hpp"
+#include "fx.hpp"
+#include "arena.hpp"
 
 // constants
 #define PICO_AUDIO_PACK_I2S_DATA 9
 #define PICO_AUDIO_PACK_I2S_BCLK 10
-#define NB_INSTRUMENTS 11
+#define DRUMS 11					// percussion instrument; never changed by the change instrument function
+#define STEREO_WIDTH 0x5000			// stereo output: pan of the outermost channels of a song (0x7fff = hard left / right)
 
 #define LOAD				0x08
 #define CHANGE_INSTRUMENT	0x18
 #define RESET_POS			0x28
+#define NEXT_SONG			0x38		// setlist mode: go to next song of the setlist
+#define PREVIOUS_PAGE		0x48		// load mode: previous page of songs
+#define NEXT_PAGE			0x58		// load mode: next page of songs
+#define NEXT_VIEW			0x68		// load mode: next view of the song directory (all songs, then songs of each tag)
+
+#define SONGS_PER_PAGE	64			// load mode: one song per pad of the 8x8 grid
+
+#define LED_FRAME		0x80		// launchpad leds: 8x8 grid plus right column (pads 0x00 to 0x78)
+#define PRELOAD_STEPS	8			// number of steps of next song prepared each time preload task runs
 
 #define LED_GPIO	25	// onboard led
 #define LED2_GPIO	255	// 2nd led
@@ -60,8 +82,27 @@ const uint NO_LED2_GPIO = 255;
 #define S1			1
 #define S2			2
 #define RESET		4
+#define SWITCH_MASK	((1u << SWITCH_1) | (1u << SWITCH_2) | (1u << SWITCH_3))
 
 #define EXIT_FUNCTION	2000000		// 2000000 usec = 2 sec
+#define PERSIST_DELAY	500000		// 500000 usec = 0.5 sec: state is saved in flash once it has not changed for this time
+#define DEBOUNCE		30000		// 30000 usec = 30 ms
+#define CONSOLE_LG		64			// max length of a console command, or of a recorder log line
+
+#define METER_CC		0x68		// cpu load meter: top row of the launchpad, CC 0x68 to 0x6F
+#define METER_LEDS		8
+#define METER_WINDOW	500000		// 500000 usec = 0.5 sec: the meter shows the peak load over this time
+#define METER_WARNING	80			// load is reported over stdio when peak goes over 80% of the buffer time
+#define BOOT_LOAD_BUFFERS	4		// buffers rendered at boot to measure the render load
+
+// usb midi devices: one device per role
+#define NOVATION_VID	0x1235		// launchpads are used as UI, other novation devices as control surface
+#define MIDI_TX_LG		256			// midi events waiting to be sent, per device
+#define MIDI_TX_BURST	3			// max midi events sent to a device at a time, to avoid blocking launchpad
+#define KEYBOARD_CENTER	60			// keyboard: middle C means no transposition
+#define TRANSPOSE_MAX	12			// keyboard: transposition is at most +/- 1 octave
+#define MIDI_VELOCITY	100			// velocity of the notes sent to a midi device by external presets
+#define NO_NOTE			0xFF		// external channel is not playing any note
 
 // type definition
 struct pedalboard {
@@ -69,17 +110,36 @@ struct pedalboard {
 	bool change_state;		// describes whether pedal state has changed from last call
 	int change_value;		// describes pedal value when state is changed
 	uint64_t change_time;	// describes time elapsed between previous state change and current state change (ie. between previous press and current press); 0 if no state change
+	uint64_t time;			// time of the current state change in usec since boot, as captured by the gpio interrupt
 };
 int next_switch;			// value of the switch that should be pressed to do "next" step; 0 if no value assigned yet
 
-// type definition
-struct songstep {
-	int step_number;					// current step number
-	int number_of_steps;				// number of steps in the song
-	int number_of_channels;				// number of channels in the song
-	uint16_t notes [CHANNEL_COUNT];		// channel data (ie. notes) for that step
-	uint8_t pad_number;					// pad number on the MIDI control surface
-	uint8_t pad_color;					// pad color on the MIDI control surface
+struct pedal_edge {						// this struct is used to pass switch edges from gpio interrupt to main loop
+	uint64_t time;						// time of the edge in usec since boot
+	uint32_t levels;					// level of the switch gpios right after the edge
+};
+
+enum midi_event_type : uint8_t {		// type of midi events received from the control surface
+	PAD_PRESSED,						// pad is pressed (note on, velocity > 0)
+	PAD_RELEASED,						// pad is released (note on with velocity 0, or note off)
+	KEY_PRESSED,						// key is pressed on the keyboard
+	CLOCK_TICK,							// midi clock tick (0xF8), from any device
+	CLOCK_START,						// midi clock start (0xFA)
+	CLOCK_CONTINUE,						// midi clock continue (0xFB)
+	CLOCK_STOP							// midi clock stop (0xFC)
+};
+
+struct midi_event {						// this struct is used to pass received midi events from usb callback to main loop
+	uint32_t time;						// reception time in usec since boot
+	uint8_t type;						// event type (see midi_event_type)
+	uint8_t pad;						// pad number
+	uint8_t value;						// velocity
+	uint8_t role;						// role of the device the event comes from (see midi_role)
+};
+
+struct midi_sysex {						// this struct is used to pass received SysEx messages from usb callback to main loop
+	uint16_t length;					// length of the message, F0 and F7 excluded
+	uint8_t data [MIDI_SYSEX_MAX];		// SysEx data
 };
 
 struct midisend {						// this struct is used to send midi data
@@ -87,12 +147,48 @@ struct midisend {						// this struct is used to send midi data
 	uint8_t mididata [3];				// midi data; max 3 bytes
 };
 
+enum midi_role {						// role of a usb midi device; a single device per role
+	ROLE_UI,							// launchpad: pads and leds
+	ROLE_CONTROL,						// second control surface: pads, as on the launchpad
+	ROLE_KEYBOARD,						// keyboard: live transposition
+	MIDI_ROLES
+};
+
+struct midi_device {					// usb midi device
+	uint8_t addr;						// usb device address; 0 if no device has this role
+	bool connected;						// device is configured
+	struct midi_parser parser;			// parser for midi data received on cable 0
+	spsc_ring<struct midisend, MIDI_TX_LG> *tx;	// midi events to be sent to the device, in the arena
+};
+
+struct prepared_song {					// next song of the setlist, prepared in the background while current song is played
+	int num = -1;						// song number; -1 if no song is being prepared
+	int number_of_channels;				// number of channels in the song
+	int number_of_steps;				// number of steps in the song
+	int instruments [CHANNEL_COUNT];	// instrument of each channel
+	struct songstep first_step;			// step 0 of the song
+	uint8_t leds [LED_FRAME];			// led frame of the song: color of each launchpad led
+	int progress;						// number of steps already set in the led frame
+	bool ready;							// song is fully prepared: switching to it is immediate
+	bool failed;						// song data could not be prepared: song will be loaded with load_song ()
+};
+
+struct attack_key {						// what the attack cache has been rendered for: any change means the cache is stale
+	int song_num;
+	int step_number;
+	int instr_offset;
+	int transpose;
+};
+
 // globals
-static uint8_t midi_dev_addr = 0;
-static bool connected = false;
+static struct midi_device midi_devices [MIDI_ROLES];	// usb midi devices, by role
+static int transpose = 0;				// transposition in semitones, set with the keyboard
 static int song_num = 0;			// by default, song number is 000
 static int number_of_songs;			// number of song in song.h
 static int instr_offset = 0;		// instrument offset: used to change instrument of the song
+static int channel_instruments [CHANNEL_COUNT];	// instrument loaded in each channel, so that it can be reloaded when its preset changes
+static uint16_t channel_routes [CHANNEL_COUNT];	// route of the instrument of each channel: synth or midi device (see presets.hpp)
+static uint8_t external_notes [CHANNEL_COUNT];	// midi note played by each external channel; NO_NOTE if none
 static struct songstep cur_step;	// contains data for currently played step of the song
 static struct songstep next_step;	// contains data for next step that should be played in the song
 static int next_step_number;		// number of next step in the song
@@ -101,144 +197,215 @@ static bool load_pressed = false;			// used for loading functionality
 static bool load_unpressed = false;			// used for loading functionality
 static bool load = false;					// used for loading functionality
 static bool instr_pressed = false;			// used for change instrument functionality
+static int load_view = 0;					// load mode: view of the song directory being browsed
+static int load_page = 0;					// load mode: page of the view being browsed
+static const struct song_entry* load_entry = NULL;	// load mode: directory entry of the selected song
+
+static struct audio_buffer_pool *ap;		// audio buffers
+static struct pedalboard pedal;				// pedal state
+static uint32_t audio_underruns = 0;		// number of times i2s has run out of audio
+static struct audio_load meter_load;		// render time of audio buffers, for the meter window
+static struct audio_load total_load;		// render time of audio buffers, since last "load" report
+static uint8_t meter_shown [METER_LEDS];	// colors of the meter leds, as sent to the launchpad
+
+// setlist mode
+#ifdef SETLIST
+static const int setlist [] = { SETLIST };	// order in which songs are played, given at build time (eg. -DSETLIST=3,0,7)
+#define SETLIST_LENGTH	((int) (sizeof (setlist) / sizeof (setlist [0])))
+#endif
+static int setlist_pos = 0;					// position of current song in the setlist
+static struct prepared_song prepared;			// next song of the setlist
+static struct persist_state saved_state;	// song, position and instrument offset as saved in flash
+static struct persist_state pending_state;	// song, position and instrument offset to be saved in flash
+static uint64_t pending_time = 0;			// time pending_state has last changed
+static bool persist_erase = true;			// spare flash sector may have to be erased
+static uint8_t led_shown [LED_FRAME];		// led colors as sent to the launchpad; used to send only the leds that change
+static struct attack_key cached_key = {-1, -1, -1, 0};	// step held by the attack cache
 
 
 // midi buffers
 #define RX_LG	500						// 500 bytes to receive
-#define TX_LG	1000					// 1000 midi events to send
-static uint8_t midi_rx [RX_LG];			// large midi buffer to receive data
-static struct midisend midi_tx [TX_LG];	// large midi buffer to send data
-static int index_tx = 0;				// number of events to be sent
+static uint8_t *midi_rx;				// large midi buffer to receive data, in the arena
+
+// startup arena: budget of each subsystem, by arena owner (see arena.hpp)
+static constexpr uint32_t arena_budgets [ARENA_OWNERS] = {
+	arena_size (RX_LG) + (MIDI_ROLES * arena_size (sizeof (*midi_devices [0].tx))),
+	synth::Engine::supports (synth::Waveform::PERCUSSION) ? synth::PERCUSSION_FRAMES * sizeof (int16_t) : 0,
+	TRACE_ARENA_BYTES,
+	REC_ARENA_BYTES,
+	ATTACK_CACHE_ARENA_BYTES,
+	FX_ARENA_BYTES
+};
+static uint8_t arena_ram [arena_total (arena_budgets)] __attribute__ ((aligned (ARENA_ALIGN)));
+
+// pedal edges captured by gpio interrupt
+static spsc_ring<struct pedal_edge, 32> pedal_edges;
+// midi events decoded by usb callback
+static spsc_ring<struct midi_event, 64> midi_events;
+// SysEx messages received by usb callback (preset changes)
+static spsc_ring<struct midi_sysex, 4> midi_sysex_messages;
 
 
 // channels definition
 using namespace synth;
 synth::AudioChannel synth::channels[CHANNEL_COUNT];
 
-// 0: piano
-// 1: piano2
-// 2: reed
-// 3: guitar
-// 4: pluckedguitar
-// 5: bass
-// 6: violin
-// 7: horn
-// 8: oboe
-// 9: clarinette
-// 10: flute
-
-// waveform, attack in ms, decay in ms, sustain volume (0xafff = 70% of max volume), sustain in ms,
-// release in ms, channel volume (set at 10000 to avoid saturation; it can be up to 0xffff)
-const uint32_t instruments[NB_INSTRUMENTS][7] = {
-	Waveform::PIANO, 30, 20, 0xafff, 2000, 1000, 10000,
-	Waveform::PIANO2, 30, 20, 0xafff, 2000, 1000, 10000,
-	Waveform::REED, 30, 20, 0xafff, 2000, 1000, 10000,
-	Waveform::GUITAR, 10, 10, 0xafff, 1000, 500, 10000,
-	Waveform::PLUCKEDGUITAR, 10, 10, 0xafff, 1000, 500, 10000,
-	Waveform::SQUARE, 10, 10, 0xafff, 1000, 500, 5000,
-	Waveform::VIOLIN, 50, 200, 0xafff, 500, 5000, 10000,
-	Waveform::HORN, 120, 50, 0xafff, 2000, 100, 10000,
-	Waveform::OBOE, 120, 50, 0xafff, 2000, 100, 10000,
-	Waveform::CLARINETTE, 120, 50, 0xafff, 2000, 100, 10000,
-	Waveform::FLUTE, 120, 50, 0xafff, 2000, 100, 10000	
-
-//	Waveform::TRIANGLE | Waveform::SQUARE, 16, 168, 0xafff, 10000, 168, 10000,		//melody
-//	Waveform::SINE | Waveform::SQUARE, 38, 300, 0, 0, 0, 12000,						//rhythm
-//	Waveform::NOISE, 5, 10, 16000, 10000, 100, 18000,								//drum
-//	Waveform::NOISE, 5, 5, 8000, 10000, 40, 8000,									//hihat
-//	Waveform::SQUARE, 10, 100, 0, 0, 500, 12000,									//bass
+// frequency ratio of a transposition from -12 to +12 semitones (Q16)
+const uint32_t semitones [(2 * TRANSPOSE_MAX) + 1] = {
+	32768,34716,36781,38968,41285,43740,46341,49097,52016,55109,58386,61858,
+	65536,
+	69433,73562,77936,82570,87480,92682,98193,104032,110218,116772,123715,131072
 };
 
 
+static_assert (PRESET_ROLES == MIDI_ROLES, "presets must be routed to midi roles");
+static_assert (SAMPLES_PER_BUFFER <= FX_FRAMES, "audio buffers must fit in the effect bus");
+
+struct midi_note_table {				// frequency half a semitone above each midi note (Q8 Hz)
+	uint32_t upper [128];
+};
+
+// built at compile time from A4 (note 69) = 440 Hz
+constexpr struct midi_note_table make_midi_notes (void)
+{
+	struct midi_note_table table = {};
+	double frequency = 440.0 * 1.0293022366434921;		// 2^(1/24): half a semitone
+
+	for (int i = 69; i < 128; i++, frequency *= 1.0594630943592953) table.upper [i] = (uint32_t) ((frequency * 256.0) + 0.5);
+	frequency = 440.0 * 1.0293022366434921;
+	for (int i = 68; i >= 0; i--) {
+		frequency /= 1.0594630943592953;				// 2^(1/12): a semitone
+		table.upper [i] = (uint32_t) ((frequency * 256.0) + 0.5);
+	}
+	return table;
+}
+
+constexpr struct midi_note_table midi_notes = make_midi_notes ();
+
+
+
+// queue a midi event to be sent to the device with a given role
+// events are kept even if no device has this role yet; returns false if the queue is full
+bool queue_midi (int role, uint8_t status, uint8_t data1, uint8_t data2)
+{
+	struct midisend event;
+
+	event.mididata [0] = status;
+	event.mididata [1] = data1;
+	event.mididata [2] = data2;
+	event.midilength = 3;						// 3 bytes to send
+	return midi_devices [role].tx->push (event);
+}
+
 
-// write midi events stored in midi_tx buffer to midi out
+// write midi events queued for a device to midi out, at most MIDI_TX_BURST events at a time
 // returns true if data was actually sent, false if not
-bool send_midi (void)
+bool send_midi (struct midi_device* device)
 {
 	uint32_t nwritten, lg;
 	uint8_t buffer [20];		// small buffer, we should not write more than 3 x 3 = 9 bytes at a time
-	int i, number;
-	int midilimit = 3;
+	int i;
+	struct midisend event;
 
-	// set a limit of sending 3 midi events at a time, to avoid blocking launchpad
-	number = index_tx;
-	if (number > midilimit) number = midilimit;
+	if (!device->connected || (tuh_midih_get_num_tx_cables(device->addr) < 1)) return false;
 
 	// build buffer to be sent, from midi data
 	lg = 0;
-	for (i = 0; i < number; i++) {
-		memcpy (&buffer [lg], midi_tx [i].mididata, midi_tx [i].midilength);
-		lg += midi_tx [i].midilength;
+	for (i = 0; (i < MIDI_TX_BURST) && device->tx->pop (event); i++) {
+		memcpy (&buffer [lg], event.mididata, event.midilength);
+		lg += event.midilength;
 	}
+	if (lg == 0) return false;
 
 	// for debug only
-	// printf ("send : %d, num evts : %d, data : %02X %02X %02X\n", lg, index_tx, buffer[0], buffer[1], buffer[2]);
+	// printf ("send : %d, num evts : %d, data : %02X %02X %02X\n", lg, device->tx->count (), buffer[0], buffer[1], buffer[2]);
 
-	if (connected && tuh_midih_get_num_tx_cables(midi_dev_addr) >= 1)
-	{
-		nwritten = tuh_midi_stream_write(midi_dev_addr, 0, buffer, lg);
-		if (nwritten != lg) {
-			TU_LOG1("Warning: Dropped %ld bytes\r\n", (lg-nwritten));
-		}
-
-		// data has been sent somehow: remove midi events that have been sent
-		memmove (midi_tx, &(midi_tx [number]), TX_LG - number);
-		// update number of events still to be sent
-		index_tx -= number;
-		return true;
+	nwritten = tuh_midi_stream_write(device->addr, 0, buffer, lg);
+	TRACE (TRACE_MIDI_TX, lg, buffer [0] | (buffer [1] << 8) | (buffer [2] << 16));
+	if (nwritten != lg) {
+		TU_LOG1("Warning: Dropped %ld bytes\r\n", (lg-nwritten));
 	}
-	return false;
+	return true;
+}
+
+
+// gpio interrupt for the pedal switches: timestamp the edge and queue it for test_switch ()
+// pedal response time thus does not depend on how long the main loop takes
+void pedal_irq (uint gpio, uint32_t events)
+{
+	struct pedal_edge edge;
+
+	(void) gpio;
+	(void) events;
+	edge.time = time_us_64 ();
+	edge.levels = gpio_get_all () & SWITCH_MASK;
+	pedal_edges.push (edge);
+}
+
+
+// convert switch gpio levels to switch values; switch is pressed when line is down (level 0)
+int switch_from_levels (uint32_t levels, int pedal_to_check)
+{
+	int result = 0;
+
+	if ((pedal_to_check & S1) && !(levels & (1u << SWITCH_1))) result |= S1;
+	if ((pedal_to_check & S2) && !(levels & (1u << SWITCH_2))) result |= S2;
+	if ((pedal_to_check & RESET) && !(levels & (1u << SWITCH_3))) result |= RESET;
+	return result;
 }
 
 
 // test switches and return which switch has been pressed (returns 0 if none)
+// switch edges are captured and timestamped by pedal_irq (); anti-bounce is done on these timestamps
 int test_switch (int pedal_to_check, struct pedalboard* pedal)
 {
-	int result = 0;
+	int result;
+	struct pedal_edge edge;
+	uint64_t now;
 	static int previous_result = 0;						// previous value for result, required for anti-bounce; this MUST BE static
-	static uint64_t this_press, previous_press = 0;		// time between 2 state changes; this MUST be static
-
+	static uint64_t previous_press = 0;					// time of previous state change; this MUST be static
 
-	// determine for how long we are in the current state
-	this_press = to_us_since_boot (get_absolute_time());
-	// determine time elapsed between previous state change and current state change (ie. between previous press and current press)
-	pedal->change_time = this_press - previous_press;
 
 	// by default, we assume there is no change in the pedal state (ie. same pedals are pressed / unpressed as for previous function call)
 	pedal->change_state = false;
-
-	// test if switch has been pressed
-	// in this case, line is down (level 0)
-	if ((pedal_to_check & S1) && gpio_get (SWITCH_1)==0) {
-		result |= S1;
-	}
-
-	if ((pedal_to_check & S2) && gpio_get (SWITCH_2)==0) {
-		result |= S2;
-	}
-
-	if ((pedal_to_check & RESET) && gpio_get (SWITCH_3)==0) {
-		result |= RESET;
+	pedal->change_time = 0;
+	result = previous_result;
+
+	// go through the edges captured by the interrupt; first edge changing the pedal state and not being a bounce is the new state
+	while (pedal_edges.pop (edge)) {
+		result = switch_from_levels (edge.levels, pedal_to_check);
+		if (result == previous_result) continue;					// edge on a switch we don't check, or back to the same state
+		if ((edge.time - previous_press) < DEBOUNCE) {				// change of state within less than 30ms: we assume this is a bounce
+			result = previous_result;
+			continue;
+		}
+		pedal->change_state = true;
+		pedal->time = edge.time;
+		break;
 	}
 
-	// check whether there has been a change of state in the pedal (pedal pressed or unpressed...)
-	// this allows to have anti-bouncing when pedal goes from unpressed to pressed, or from pressed to unpressed
-	if (result != previous_result) {
-		// anti-bouncing functionality
-		if (pedal->change_time < 30000) {		// change of state within less than 30ms: we assume this is a bounce; we keep previous values
-			pedal->value = previous_result;
-			return previous_result;				// if previous call was done less than 30ms, then leave
+	// a bounce may have hidden the last edge: once the anti-bounce window is over, make sure we are in line with the actual switch state
+	if (!pedal->change_state && pedal_edges.empty ()) {
+		now = time_us_64 ();
+		if ((now - previous_press) >= DEBOUNCE) {
+			result = switch_from_levels (gpio_get_all () & SWITCH_MASK, pedal_to_check);
+			if (result != previous_result) {
+				pedal->change_state = true;
+				pedal->time = now;
+			}
 		}
+	}
 
+	if (pedal->change_state) {
 		// pedal state has changed; set variables accordingly
-		pedal->change_state = true;
 		pedal->change_value = previous_result;
-		previous_press = this_press;
-	}
+		pedal->change_time = pedal->time - previous_press;
+		previous_press = pedal->time;
 
-	// LED ON or LED OFF depending if a switch has been pressed
-	if (NO_LED_GPIO != LED_GPIO) gpio_put(LED_GPIO, (result ? true : false));		// if onboard led and if we are within time window, lite LED on/off
-	if (NO_LED2_GPIO != LED2_GPIO) gpio_put(LED2_GPIO, (result ? true : false));	// if another led and if we are within time window, lite LED on/off
+		// LED ON or LED OFF depending if a switch has been pressed
+		if (NO_LED_GPIO != LED_GPIO) gpio_put(LED_GPIO, (result ? true : false));		// if onboard led and if we are within time window, lite LED on/off
+		if (NO_LED2_GPIO != LED2_GPIO) gpio_put(LED2_GPIO, (result ? true : false));	// if another led and if we are within time window, lite LED on/off
+	}
 
 	// copy pedal values and return
 	previous_result = result;
@@ -251,39 +418,36 @@ int test_switch (int pedal_to_check, struct pedalboard* pedal)
 void reset_launchpad ()
 {
 	// basically we just add the right midi command to outgoing midi flow
-	midi_tx [index_tx].mididata [0] = 0xB0;			// reset launchpad
-	midi_tx [index_tx].mididata [1] = 0x00;
-	midi_tx [index_tx].mididata [2] = 0x00;
-	midi_tx [index_tx++].midilength = 3;			// 3 bytes to send
+	queue_midi (ROLE_UI, 0xB0, 0x00, 0x00);			// reset launchpad
 	// basically we just add the right midi command to outgoing midi flow
-	midi_tx [index_tx].mididata [0] = 0xB0;			// grid type XY
-	midi_tx [index_tx].mididata [1] = 0x00;
-	midi_tx [index_tx].mididata [2] = 0x01;
-	midi_tx [index_tx++].midilength = 3;			// 3 bytes to send
+	queue_midi (ROLE_UI, 0xB0, 0x00, 0x01);			// grid type XY
+	// all leds are now off
+	memset (led_shown, 0, sizeof (led_shown));
+	memset (meter_shown, 0, sizeof (meter_shown));
 }
 
 
-// set launchpad led to its original color for a given step 
-void set_led (struct songstep* step)
+// set launchpad led of a pad to a color
+void set_pad_led (uint8_t pad, uint8_t color)
 {
 	// basically we just add the right midi command to outgoing midi flow
 	// this is NOTE ON (pad number) (pad color)
-	midi_tx [index_tx].mididata [0] = 0x90;
-	midi_tx [index_tx].mididata [1] = step->pad_number;
-	midi_tx [index_tx].mididata [2] = step->pad_color;
-	midi_tx [index_tx++].midilength = 3;			// 3 bytes to send
+	queue_midi (ROLE_UI, 0x90, pad, color);
+	led_shown [pad & (LED_FRAME - 1)] = color;
+}
+
+
+// set launchpad led to its original color for a given step 
+void set_led (struct songstep* step)
+{
+	set_pad_led (step->pad_number, step->pad_color);
 }
 
 
 // set launchpad led to a nice green color for a given step 
 void set_green_led (struct songstep* step)
 {
-	// basically we just add the right midi command to outgoing midi flow
-	// this is NOTE ON (pad number) (pad color)
-	midi_tx [index_tx].mididata [0] = 0x90;
-	midi_tx [index_tx].mididata [1] = step->pad_number;
-	midi_tx [index_tx].mididata [2] = 0x3C;
-	midi_tx [index_tx++].midilength = 3;			// 3 bytes to send
+	set_pad_led (step->pad_number, 0x3C);
 }
 
 
@@ -298,6 +462,8 @@ struct songstep temp; 					// temporary structure to store step data for the son
 	set_green_led (&temp);
 	temp.pad_number = RESET_POS;			// reset position button
 	set_green_led (&temp);
+	temp.pad_number = NEXT_SONG;			// next song button
+	set_green_led (&temp);
 }
 
 
@@ -313,49 +479,14 @@ void reset_leds ()
 }
 
 
-// get step data from the song and fill the step structure accordingly
-// num is the song number, position is the step number
-// returns true if step data is OK, false otherwise
-bool get_step (int num, int position, struct songstep* step)
+// repaint the launchpad with a led frame: only the leds that differ from what is shown are sent
+void commit_leds (const uint8_t* frame)
 {
-int pointer;
-int i;
-
-
-	// check if song exists by checking that song number is lower than number of songs
-	if (num >= song [0]) return false;
-
-	// get pointer to song data
-	pointer = song [1+num];
-
-	// get number of channels and steps
-	step->number_of_channels = song [pointer++];
-	step->number_of_steps = song [pointer++];
+	int pad;
 
-	// no need to load instruments of the song to the channels, this is done when loading a song
-	// this could be done only once at song loading
-	pointer += step->number_of_channels;
-
-	// determine if we are still within the song; if not, return false
-	if (position >= step->number_of_steps) return false;
-
-	// update pointer so it points to step data
-	pointer = pointer + (position * (step->number_of_channels + 2));	// nb_chan + 2 as we need to skip pad number and color
-
-	// get song data (at position) and load structure with it
-	// make sure we are not at the end of the song
-	for (i = 0; i < step->number_of_channels; i++) {
-		step->notes [i] = song [pointer];
-		if (step->notes [i] == 0xFFFF) return false;
-		pointer++;							// next position in song file
+	for (pad = 0; pad < LED_FRAME; pad++) {
+		if (frame [pad] != led_shown [pad]) set_pad_led (pad, frame [pad]);
 	}
-
-	// fill pad number and pad color, and obviously step number
-	step->pad_number = song [pointer++];
-	step->pad_color = song [pointer];
-	step->step_number = position;
-
-	return true;
 }
 
 
@@ -402,15 +533,87 @@ int nbstep;
 }
 
 
-// plays the notes contained in songstep structure
-void update_playback (struct songstep* step) {
+// set the notes contained in songstep structure on voices, and trigger them
+void set_voices (AudioChannel* voices, struct songstep* step) {
 
 int i;
 
 	// get notes data from the structure, and pass it to synthetizer
+	// notes are transposed, except on percussion channels where the note selects the drum
+	// channels routed to a midi device are left off (see play_external ())
+	for (i = 0; i < step->number_of_channels; i++) {
+		if (channel_routes [i] & PRESET_EXTERNAL) continue;
+		if ((transpose == 0) || (voices[i].waveforms & Waveform::PERCUSSION)) voices[i].frequency = step->notes [i];
+		else voices[i].frequency = (uint16_t) ((step->notes [i] * semitones [transpose + TRANSPOSE_MAX]) >> 16);
+		voices[i].trigger_attack();
+	}
+}
+
+
+// midi note nearest to a frequency of the song data (Hz)
+int midi_note (uint32_t frequency)
+{
+	int low = 0;
+	int high = 127;
+	int middle;
+
+	// first note whose upper frequency is above the frequency
+	frequency <<= 8;
+	while (low < high) {
+		middle = (low + high) / 2;
+		if (frequency < midi_notes.upper [middle]) high = middle;
+		else low = middle + 1;
+	}
+	return low;
+}
+
+
+// release the note played by an external channel, if any
+void external_note_off (int chan)
+{
+	if (external_notes [chan] == NO_NOTE) return;
+	queue_midi (PRESET_ROLE (channel_routes [chan]), 0x80 | PRESET_CHANNEL (channel_routes [chan]), external_notes [chan], 0);
+	external_notes [chan] = NO_NOTE;
+}
+
+
+// send the notes of the channels routed to a midi device
+// as on the synth, a new note replaces the previous one of the channel, and 0 stops it
+void play_external (struct songstep* step)
+{
+	int i, note;
+	uint16_t route;
+
 	for (i = 0; i < step->number_of_channels; i++) {
-		channels[i].frequency = step->notes [i];
-		channels[i].trigger_attack();
+		route = channel_routes [i];
+		if (!(route & PRESET_EXTERNAL)) continue;
+		external_note_off (i);
+		if (step->notes [i] == 0) continue;
+		// drums: general midi kick, snare and closed hat, chosen as on the synth (see trigger_percussion ())
+		if (route & PRESET_DRUMS) note = (step->notes [i] < 1000) ? 36 : ((step->notes [i] < 10000) ? 38 : 42);
+		else {
+			note = midi_note (step->notes [i]) + transpose;
+			if (note < 0) note = 0;
+			if (note > 127) note = 127;
+		}
+		queue_midi (PRESET_ROLE (route), 0x90 | PRESET_CHANNEL (route), note, MIDI_VELOCITY);
+		external_notes [i] = note;
+	}
+}
+
+
+// plays the notes contained in songstep structure
+// cached is true if the attack cache holds the step: it is then played from the cache
+void update_playback (struct songstep* step, bool cached = false) {
+
+int i;
+
+	// live voices take over from the cache, if it is being played
+	attack_cache_stop ();
+	if (!(cached && attack_cache_play ())) set_voices (channels, step);
+	play_external (step);
+	for (i = 0; i < step->number_of_channels; i++) {
+		TRACE (TRACE_VOICE_ON, i, step->notes [i]);
 	}
 }
 
@@ -419,8 +622,11 @@ int i;
 void stop_playback () {
 
   // we must update the playback with release on all channels
+	TRACE (TRACE_VOICE_OFF, 0, 0);
+	attack_cache_stop ();
 
 	for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+		external_note_off (i);
     	// if channel is in OFF state, then do nothing
     	// if channel is already in release state, then do nothing
     	// if channel is in another state, then go to release state
@@ -435,7 +641,9 @@ void stop_playback () {
 void reset_playback () {
 
 	// we must stop all channels
+	attack_cache_stop ();
 	for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+		external_note_off (i);
 		channels[i].off ();
 	}
 }
@@ -444,35 +652,40 @@ void reset_playback () {
 // load an instrument of a song into a channel
 bool load_instrument(int instr, int chan) {
 
+	const Instrument* instrument;
+
 	// check boundaries
-	if ((instr <0) || (instr >= NB_INSTRUMENTS)) return false;
 	if ((chan <0) || (chan >= CHANNEL_COUNT)) return false;
+	// check the instrument exists, and its waveforms are part of this firmware
+	instrument = preset_instrument (instr);
+	if (instrument == NULL) return false;
+	// the cache must not bring back the previous instrument
+	attack_cache_stop ();
+
+	// assign instrument parameters to the channel, as compiled from its preset
+	// a note sent to a midi device must not be left hanging when the channel changes route
+	external_note_off (chan);
+	channels[chan].set_instrument (*instrument);
+	channel_instruments [chan] = instr;
+	channel_routes [chan] = preset_route (instr);
 
-	// assign instrument parameters to the channel
-	channels[chan].waveforms   = instruments [instr][0];
-	channels[chan].attack_ms   = instruments [instr][1];
-	channels[chan].decay_ms    = instruments [instr][2];
-	channels[chan].sustain     = instruments [instr][3];
-	channels[chan].sustain_ms  = instruments [instr][4];
-	channels[chan].release_ms  = instruments [instr][5];
-	channels[chan].volume      = instruments [instr][6];
-  
 	return true;
 }
 
 
-// reset position in the song to step 0 (start)
+// set position in the song to a given step
 // returns false if an issue has occured
-bool reset_position (bool is_next_step)
+bool set_position (int step_number, bool is_next_step)
 {
 	// in case "next_step" exists already, color of "next step" pad shall be set back to normal
 	if (is_next_step) set_led (&next_step);
 
-	// initialize next step that should be played in the song to 0
+	// initialize next step that should be played in the song
 	// set corresponding led in green
 	// copy also to current step for safety
-	next_step_number = 0;
-	if (get_step (song_num, 0, &next_step) == false) return false;
+	if (get_step (song_num, step_number, &next_step) == false) return false;
+	next_step_number = step_number;
+	TRACE (TRACE_STEP, song_num, next_step_number);
 	memcpy (&cur_step, &next_step, sizeof (struct songstep));
 	set_green_led (&next_step);		// set next step pad led in green
 
@@ -483,38 +696,56 @@ bool reset_position (bool is_next_step)
 }
 
 
+// spread the channels of a song across the stereo field, from left to right; drums stay in the centre
+// pan gains are computed here, once, and only applied by the synth
+void pan_channels (int nb_chan)
+{
+	int i;
+
+	for (i = 0; i < nb_chan; i++) {
+		if ((nb_chan == 1) || (channels[i].waveforms & Waveform::PERCUSSION)) channels[i].set_pan (0);
+		else channels[i].set_pan ((int16_t) ((((2 * i) - (nb_chan - 1)) * STEREO_WIDTH) / (nb_chan - 1)));
+	}
+}
+
+
+// reset position in the song to step 0 (start)
+// returns false if an issue has occured
+bool reset_position (bool is_next_step)
+{
+	return set_position (0, is_next_step);
+}
+
+
 // load song with number NUM
 bool load_song (int num)
 {
-int pointer;
 int nb_chan;
 int nb_step;
 int i;
 int instrument;
 struct songstep temp_step;
 
-	// check if song exists by checking that song number is lower than number of songs
-	if (num >= song [0]) return false;
+	// check if song exists, and get number of channels and steps
+	if (!get_song_info (num, &nb_chan, &nb_step)) return false;
+	TRACE (TRACE_SONG, num, 0);
+	rec_event (REC_SONG, num & 0xFF, num >> 8, 0);
+	clock_steps (get_song_steps_per_bar (num));
 
 	// make sure all channels are off
 	reset_playback ();
 	// clear launchpad leds, set function leds on
 	reset_leds ();
 
-	// get pointer to song data
-	pointer = song [1+num];
-
-	// get number of channels and steps
-	nb_chan = song [pointer++];
-	// get number of steps
-	nb_step = song [pointer++];
-
 	// load instruments of the song to the corresponding channel
 	for (i = 0; i < nb_chan; i++) {
 		// set instrument number based on instrument specified in the song, and potential offset to change instrument
-		instrument = (song [pointer++] + instr_offset) % NB_INSTRUMENTS;
+		// drums are kept as they are: the offset only rotates through the melodic instruments
+		instrument = get_song_instrument (num, i);
+		if (instrument != DRUMS) instrument = (instrument + instr_offset) % DRUMS;
 		if (load_instrument (instrument, i) == false) return false;
 	}
+	pan_channels (nb_chan);
 
 	// go through each step and light the corresponding pad
 	for (i = 0; i < nb_step; i++) {
@@ -533,27 +764,950 @@ struct songstep temp_step;
 void error()
 {
 	printf("Error in song data.\n");
+	TRACE (TRACE_ERROR, song_num, next_step_number);
+	reset_playback ();
+}
+
+
+// song at a given position of the setlist; without setlist, songs are played in song number order
+int setlist_song (int pos)
+{
+#ifdef SETLIST
+	return setlist [pos % SETLIST_LENGTH];
+#else
+	return pos % number_of_songs;
+#endif
+}
+
+
+// position of a song in the setlist; current position is kept if song is not part of the setlist
+int setlist_find (int num)
+{
+#ifdef SETLIST
+	int i;
+
+	for (i = 0; i < SETLIST_LENGTH; i++) {
+		if (setlist [i] == num) return i;
+	}
+	return setlist_pos;
+#else
+	return num;
+#endif
+}
+
+
+// start preparing a song: song info, instruments and function leds
+void prepare_song (int num)
+{
+	int i;
+
+	prepared.num = num;
+	prepared.progress = 0;
+	prepared.ready = false;
+	prepared.failed = false;
+	memset (prepared.leds, 0, sizeof (prepared.leds));
+	prepared.leds [LOAD] = 0x3C;
+	prepared.leds [CHANGE_INSTRUMENT] = 0x3C;
+	prepared.leds [RESET_POS] = 0x3C;
+	prepared.leds [NEXT_SONG] = 0x3C;
+
+	if (!get_song_info (num, &prepared.number_of_channels, &prepared.number_of_steps) || (prepared.number_of_channels > CHANNEL_COUNT)) {
+		prepared.failed = true;
+		return;
+	}
+	// song is always switched to with its initial instruments
+	for (i = 0; i < prepared.number_of_channels; i++) {
+		prepared.instruments [i] = get_song_instrument (num, i);
+		if (preset_instrument (prepared.instruments [i]) == NULL) prepared.failed = true;
+	}
+}
+
+
+// switch to next song of the setlist
+// in case next song has been fully prepared, this only copies the prepared song and sends the leds that differ from current song
+void next_song (void)
+{
+	int i;
+
+	setlist_pos++;
+	song_num = setlist_song (setlist_pos);
+	instr_offset = 0;							// song will be loaded with initial instruments
+
+	// next song is not ready yet (or could not be prepared): load it the usual way
+	if ((prepared.num != song_num) || !prepared.ready) {
+		if (!load_song (song_num)) error ();
+		return;
+	}
+
+	TRACE (TRACE_SONG, song_num, 1);
+	rec_event (REC_SONG, song_num & 0xFF, song_num >> 8, 0);
+	clock_steps (get_song_steps_per_bar (song_num));
 	reset_playback ();
+	for (i = 0; i < prepared.number_of_channels; i++) load_instrument (prepared.instruments [i], i);
+	pan_channels (prepared.number_of_channels);
+	memcpy (&next_step, &prepared.first_step, sizeof (struct songstep));
+	memcpy (&cur_step, &next_step, sizeof (struct songstep));
+	next_step_number = 0;
+	next_switch = 0;
+	commit_leds (prepared.leds);
 }
 
 
 
-int main() {
+// process a midi event received from the control surface
+void process_midi_event (struct midi_event* event)
+{
+	uint8_t j, k, l;
+	struct songstep temp_step;
+	const struct song_entry* entry;
+
+	// keyboard: transposition is the distance of the key to middle C, and applies from the next step played
+	if (event->type == KEY_PRESSED) {
+		transpose = event->pad - KEYBOARD_CENTER;
+		if (transpose > TRANSPOSE_MAX) transpose = TRANSPOSE_MAX;
+		if (transpose < -TRANSPOSE_MAX) transpose = -TRANSPOSE_MAX;
+		printf ("Transpose: %d\r\n", transpose);
+		return;
+	}
+
+	if (event->type == PAD_RELEASED) {
+		// if pad release is the same number as the last pad that was pressed, then sound off
+		if (event->pad == cur_step.pad_number) stop_playback ();
+		// if load button is unpressed, then set relevant state
+		if (event->pad == LOAD) load_unpressed = true;
+		return;
+	}
+
+	// else velocity is 0x7F: pad is pressed on launchpad
+	// reset position functionality
+	if (event->pad == RESET_POS) {
+		reset_position (true);
+		reset_playback ();
+		return;
+	}
+
+	// change instrumentfunctionality
+	if (event->pad == CHANGE_INSTRUMENT) {
+		instr_pressed = true;
+		reset_playback ();
+		return;
+	}
+
+	// next song functionality
+	if ((event->pad == NEXT_SONG) && !load) {
+		next_song ();
+		return;
+	}
+
+	// load functionality
+	if (event->pad == LOAD) {
+		load_pressed = true;
+		reset_playback ();
+		return;
+	}
+	if (load) {								// we are in load functionality
+		// browse the song directory: page and view buttons repaint the song pads
+		if ((event->pad == PREVIOUS_PAGE) && (load_page > 0)) {
+			load_page--;
+			load_pressed = true;
+			return;
+		}
+		if ((event->pad == NEXT_PAGE) && (get_song_entry (load_view, (load_page + 1) * SONGS_PER_PAGE) != NULL)) {
+			load_page++;
+			load_pressed = true;
+			return;
+		}
+		if ((event->pad == NEXT_VIEW) && (song_view_count () > 1)) {
+			load_view = (load_view + 1) % song_view_count ();
+			load_page = 0;
+			load_pressed = true;
+			return;
+		}
+		j = event->pad & 0x0F;				// determine which song has been pressed according to pad number: low nibble
+		k = (event->pad >> 4) & 0x0F;		// high nibble
+		if ((j < 8) && (k < 8)) {			// test boundaries of selected pad, to see if this corresponds to an existing song
+			l = (k * 8) + j;
+			// song of the pad, in the page and view being browsed
+			entry = get_song_entry (load_view, (load_page * SONGS_PER_PAGE) + l);
+			if (entry != NULL) {
+				load_entry = entry;
+				song_num = entry->song;		// set song_number with the new value
+			}
+		}
+		return;
+	}
+
+	// determine if the pressed pad is assigned to a step, and which step; we start checking the pads from next_step_number
+	// to make sure we don't miss the next step
+	if (!get_step_from_pad_number (song_num, next_step_number, event->pad, &temp_step)) error ();
+	else {
+		// we have pressed a pad that is assigned to a step
+		if (temp_step.pad_number == next_step.pad_number) {
+			// we have pressed the "next step" pad; for safety, copy "next step" values in "temp" 
+			memcpy (&temp_step, &next_step, sizeof (struct songstep));
+			// color of "next step" pad shall be set back to normal
+			set_led (&temp_step);
+			// determine next step in the song
+			if (++next_step_number >= temp_step.number_of_steps) next_step_number = 0;
+			// load new next step structure
+			if (!get_step (song_num, next_step_number, &next_step)) error ();
+			TRACE (TRACE_STEP, song_num, next_step_number);
+			// set led color of next step in a nice green
+			set_green_led (&next_step);
+		}
+		// no need to stop previous sound as:
+		// 1- whenever playing new sound stops previous sound on the same channel
+		// 2- whether having 0 as new sound frequency stops sound in the same channel
+
+		// pressed pad is becoming the current pad: fill pad structure
+		memcpy (&cur_step, &temp_step, sizeof (struct songstep));
+		// play new sound
+		update_playback (&cur_step);
+	}
+}
+
+
+// what the attack cache should hold: the next step, with current instruments and transposition
+void next_attack_key (struct attack_key* key)
+{
+	key->song_num = song_num;
+	key->step_number = next_step_number;
+	key->instr_offset = instr_offset;
+	key->transpose = transpose;
+}
+
+
+// true if the attack cache holds the next step
+bool attack_cached (void)
+{
+	struct attack_key key;
+
+	next_attack_key (&key);
+	return (memcmp (&key, &cached_key, sizeof (key)) == 0);
+}
+
+
+// move to next step of the song: it becomes the current step
+// returns true if the attack cache holds it; the cache is not used while recording or replaying, as
+// whether it is ready or not depends on idle time
+bool next_position (void)
+{
+	bool cached;
+
+	cached = attack_cached () && (rec_mode == REC_OFF);
+	memcpy (&cur_step, &next_step, sizeof (struct songstep));
+	// color of "next step" pad shall be set back to normal
+	set_led (&cur_step);
+	// determine next step in the song
+	if (++next_step_number >= cur_step.number_of_steps) next_step_number = 0;
+	// load new next step structure
+	if (!get_step (song_num, next_step_number, &next_step)) error ();
+	TRACE (TRACE_STEP, song_num, next_step_number);
+	// set led color of next step in a nice green
+	set_green_led (&next_step);
+	return cached;
+}
+
+
+// play according to pedal state change
+void play_pedal (void)
+{
+	bool cached = false;
+
+	TRACE (TRACE_PEDAL, pedal.value, 0);
+
+	// play a sound
+	if ((pedal.value == S1) || (pedal.value == S2)) {
+
+		// in case next_switch value is undetermined, force this press as being "next"
+		if (next_switch == 0) next_switch = pedal.value;
+
+		// test if we pressed "next" switch, ie. the switch that makes us move to next step in the song
+		// otherwise, current step is played again
+		if (pedal.value == next_switch) {
+			// we have pressed "next step"; its attack may be in the cache
+			cached = next_position ();
+			// assign next pedal/switch that should be pressed to have "next" step the next time
+			next_switch = ((pedal.value == S1) ? S2 : S1);
+		}
+		
+		// no need to stop previous sound as:
+		// 1- whenever playing new sound stops previous sound on the same channel
+		// 2- whether having 0 as new sound frequency stops sound in the same channel
+
+		// play new sound
+		update_playback (&cur_step, cached);
+	}
+
+	// if pedal has been released, then stop playback
+	if (pedal.value == 0) {
+		stop_playback ();
+	}
+
+	// check if RESET_POS pedal switch has been pressed for more than 2 sec
+	if ((pedal.value == 0) && (pedal.change_value & RESET)) {
+		// no pedal pressed anymore and pedal previously pressed was RESET
+		// check how much time the previous pedal was pressed; if more than 2 sec, then reset position to 0 in the song
+		if (pedal.change_time >= EXIT_FUNCTION) {
+			reset_position (true);			// reset position in the song to 0
+			reset_playback ();
+		}
+	}
+}
+
 
+// render audio, from the attack cache when it is played; the recorder counts the frames and checks the audio
+// when the song follows a midi clock, the block is split at the frame its next step is due, and the step is played there
+// (the clock is not followed while recording or replaying: its steps depend on time rather than on logged events)
+// the return of the effect bus is added last: it depends on the timing of core 1, so the recorder does not check it
+void render_audio (int16_t* samples, uint32_t count)
+{
+	static int16_t send [SAMPLES_PER_BUFFER];		// send mix of the voices to the effect bus
+	int32_t frame;
+
+	frame = (rec_mode == REC_OFF) ? clock_step_frame (count) : -1;
+	if (frame < 0) {
+		attack_cache_audio (samples, send, count);
+	}
+	else {
+		attack_cache_audio (samples, send, frame);
+		TRACE (TRACE_CLOCK, frame, clock_tempo ());
+		update_playback (&cur_step, next_position ());
+		attack_cache_audio (samples + (frame * synth::output_channels), send + frame, count - frame);
+	}
+	rec_audio (samples, count);
+	fx_audio (samples, send, count);
+}
+
+
+// midi clock: steps of the songs having steps per bar are played on the clock (see render_audio ())
+void clock_event (struct midi_event* event)
+{
+	switch (event->type) {
+		case CLOCK_TICK:
+			clock_tick (event->time);
+			break;
+		case CLOCK_START:
+			clock_start (event->time);
+			printf ("Clock started\r\n");
+			break;
+		case CLOCK_CONTINUE:
+			clock_continue (event->time);
+			break;
+		case CLOCK_STOP:
+			// sound of the last step stops with the clock, as when the pedal is released
+			if (clock_driving ()) stop_playback ();
+			clock_stop ();
+			printf ("Clock stopped, tempo %lu.%lu bpm\r\n", (unsigned long) (clock_tempo () / 10), (unsigned long) (clock_tempo () % 10));
+			break;
+		default:
+			break;
+	}
+}
+
+
+// handle a preset SysEx message: channels playing a changed preset get it at once
+// returns true if some preset has changed
+bool process_sysex (const uint8_t* data, uint16_t length)
+{
+	int i, changed;
+
+	changed = preset_sysex (data, length);
+	if (changed < 0) return false;
+	printf ("Preset %d changed\r\n", changed);
+	for (i = 0; i < CHANNEL_COUNT; i++) {
+		if ((changed == NB_INSTRUMENTS) || (channel_instruments [i] == changed)) load_instrument (channel_instruments [i], i);
+	}
+	cached_key.song_num = -1;				// the cache may hold the previous sound of the preset
+	return true;
+}
+
+
+static struct midi_sysex replay_sysex;		// SysEx message being put together from its records by replay
+
+// replay: handle the events logged at the current audio frame, before it is rendered
+void replay_events (void)
+{
+	const struct rec_record* record;
+	struct midi_event event;
+	int i;
+
+	while ((record = rec_next ()) != NULL) {
+		switch (record->type) {
+			case REC_PEDAL:
+				pedal.value = record->data [0] & 0x0F;
+				pedal.change_value = record->data [0] >> 4;
+				pedal.change_time = (record->data [1] | (record->data [2] << 8)) * 1000ULL;
+				pedal.change_state = true;
+				pedal.time = time_us_64 ();
+				play_pedal ();
+				break;
+			case REC_MIDI:
+				event.time = time_us_32 ();
+				event.type = record->data [0] & 0x0F;
+				event.role = record->data [0] >> 4;
+				event.pad = record->data [1];
+				event.value = record->data [2];
+				process_midi_event (&event);
+				break;
+			case REC_SYSEX:					// 3 bytes of the message, up to its F7
+				for (i = 0; i < 3; i++) {
+					if (record->data [i] == 0xF7) {
+						process_sysex (replay_sysex.data, replay_sysex.length);
+						replay_sysex.length = 0;
+						break;
+					}
+					if (replay_sysex.length < MIDI_SYSEX_MAX) replay_sysex.data [replay_sysex.length++] = record->data [i];
+				}
+				break;
+			default:						// markers: they are the result of the other events
+				break;
+		}
+	}
+}
+
+
+// audio task: refill audio buffers as soon as one is free
+// filling all the buffers in a row means they were all free, ie. i2s has run out of audio: this is an underrun
+bool audio_task (void)
+{
+	static int filled = 0;				// number of buffers filled in a row
+	static bool running = false;		// buffers have been full at least once: start of audio is not an underrun
+
+	if (rec_mode != REC_OFF) {
+		if (rec_mode == REC_REPLAYING) replay_events ();
+		// song loads and instrument changes requested by pads are done by led task: audio waits for them, so that
+		// they happen at the same audio frame when recorded and when replayed
+		if (load_unpressed || instr_pressed) return false;
+	}
+
+	if (!update_buffer(ap, render_audio, &meter_load)) {
+		filled = 0;
+		running = true;
+		return false;
+	}
+	if ((++filled >= AUDIO_BUFFERS) && running) {
+		audio_underruns++;
+		TRACE (TRACE_UNDERRUN, 0, audio_underruns);
+		filled = 0;
+	}
+	return true;
+}
+
+
+// input task: test pedal and play accordingly
+// returns true if pedal state has changed
+bool input_task (void)
+{
+	uint32_t change_ms;
+
+	// test pedal and check if one of them is pressed
+	test_switch (S1 | S2 | RESET, &pedal);
+
+	// check if state has changed, ie. pedal has just been pressed or unpressed
+	if (!pedal.change_state) return false;
+	// pedal is not played while a show is replayed
+	if (rec_mode == REC_REPLAYING) return true;
+
+	change_ms = pedal.change_time / 1000;
+	if (change_ms > 0xFFFF) change_ms = 0xFFFF;
+	rec_event (REC_PEDAL, pedal.value | (pedal.change_value << 4), change_ms & 0xFF, change_ms >> 8);
+	play_pedal ();
+	return true;
+}
+
+
+// midi rx task: usb host stack, then process midi events decoded by tuh_midi_rx_cb ()
+// returns true if some midi event has been processed
+bool midi_rx_task (void)
+{
+	struct midi_event event;
+	struct midi_sysex sysex;
+	bool busy = false;
+	int i;
+
+	tuh_task();
+	// check connection to USB slaves
+	for (i = 0; i < MIDI_ROLES; i++) {
+		midi_devices [i].connected = ((midi_devices [i].addr != 0) && tuh_midi_configured(midi_devices [i].addr));
+	}
+
+	// process received events; they are not played while a show is replayed
+	// clock events are not logged by the recorder: there are far too many of them
+	while (midi_events.pop (event)) {
+		busy = true;
+		if (event.type >= CLOCK_TICK) {
+			clock_event (&event);
+			continue;
+		}
+		if (rec_mode == REC_REPLAYING) continue;
+		rec_event (REC_MIDI, event.type | (event.role << 4), event.pad, event.value);
+		process_midi_event (&event);
+	}
+
+	// preset changes; they are not played while a show is replayed either
+	// only the messages which change presets are logged: a store in flash is not replayed
+	while (midi_sysex_messages.pop (sysex)) {
+		busy = true;
+		if (rec_mode == REC_REPLAYING) continue;
+		if (process_sysex (sysex.data, sysex.length)) rec_sysex (sysex.data, sysex.length);
+	}
+	return busy;
+}
+
+
+// midi tx task: in case some MIDI data is to be sent, then send it
+// devices are served in turn, a burst of events each time, so that a long led repaint of one device
+// does not delay the data of the others
+// returns true if data has been sent
+bool midi_tx_task (void)
+{
+	static int next_device = 0;			// device to be served first
+	bool sent = false;
+	int i, role;
+
+	for (i = 0; i < MIDI_ROLES; i++) {
+		role = (next_device + i) % MIDI_ROLES;
+		if (send_midi (&midi_devices [role])) {
+			next_device = role + 1;
+			sent = true;
+			break;
+		}
+	}
+
+	// write pending MIDI data to the devices
+	for (i = 0; i < MIDI_ROLES; i++) {
+		if (midi_devices [i].connected) tuh_midi_stream_flush(midi_devices [i].addr);
+	}
+	return sent;
+}
+
+
+// led task: load and change instrument functionalities, which repaint the launchpad leds
+// returns true if some function has been processed
+bool led_task (void)
+{
 	int i, j, k;
 	struct songstep temp_step;
-	struct pedalboard pedal;
+	const struct song_view* view;
+	bool busy = false;
+
+	// load functionality
+	if (load_pressed) {			// load pad has just been pressed, or page / view has changed
+		reset_leds ();			// clear leds and light function leds
+		// set leds on, according to the songs of the page
+		k = 0;
+		while ((k < SONGS_PER_PAGE) && (get_song_entry (load_view, (load_page * SONGS_PER_PAGE) + k) != NULL)) {		// load mode : set existing songs as green buttons (green pads)
+
+			i = k / 8;
+			j = k % 8;
+			temp_step.pad_number = (i * 0x10) + j;		// set song button to green
+			set_green_led (&temp_step);
+			
+			k++;
+		}
+		// page and view buttons are lit in amber when they can be used
+		if (load_page > 0) set_pad_led (PREVIOUS_PAGE, 0x3F);
+		if (get_song_entry (load_view, (load_page + 1) * SONGS_PER_PAGE) != NULL) set_pad_led (NEXT_PAGE, 0x3F);
+		if (song_view_count () > 1) set_pad_led (NEXT_VIEW, 0x3F);
+		view = get_song_view (load_view);
+		printf ("Songs: %s, page %d/%d\n", view->name, load_page + 1, (view->count + SONGS_PER_PAGE - 1) / SONGS_PER_PAGE);
+		load_pressed = false;
+		load = true;
+		busy = true;
+	}
+	if (load_unpressed) {							// load pad has just been unpressed
+		load = false;
+		load_unpressed = false;
+		instr_offset = 0;							// song will be loaded with initial instruments
+		setlist_pos = setlist_find (song_num);		// setlist goes on from the loaded song
+		if (load_entry != NULL) printf ("Song %d: %s\n", load_entry->song, load_entry->name);
+		load_entry = NULL;
+		if (!load_song (song_num)) error ();		// load new song according to song_num
+		busy = true;
+	}
+
+	// change instrument functionality
+	if (instr_pressed) {			// change instr pad has just been pressed
+		instr_offset++;				// increase instrument offset to change to next instr
+		rec_event (REC_INSTRUMENT, instr_offset, 0, 0);
+		if (!load_song (song_num)) error ();		// load current song again to reload the instruments
+		instr_pressed = false;
+		busy = true;
+	}
+
+	return busy;
+}
+
+
+// preload task: prepare next song of the setlist in the background, a few steps at a time
+// returns true if some preparation has been done
+bool preload_task (void)
+{
+	int i, num;
+	struct songstep temp_step;
+
+	num = setlist_song (setlist_pos + 1);
+	if (prepared.num != num) {
+		prepare_song (num);
+		return true;
+	}
+	if (prepared.ready || prepared.failed) return false;
+
+	// light the pads of the next steps of the song
+	for (i = 0; (i < PRELOAD_STEPS) && (prepared.progress < prepared.number_of_steps); i++) {
+		if (!get_step (num, prepared.progress++, &temp_step)) {
+			prepared.failed = true;
+			return true;
+		}
+		prepared.leds [temp_step.pad_number & (LED_FRAME - 1)] = temp_step.pad_color;
+	}
+
+	// all steps are done: song starts at step 0, set in green
+	if (prepared.progress >= prepared.number_of_steps) {
+		if (!get_step (num, 0, &prepared.first_step)) {
+			prepared.failed = true;
+			return true;
+		}
+		prepared.leds [prepared.first_step.pad_number & (LED_FRAME - 1)] = 0x3C;
+		prepared.ready = true;
+	}
+	return true;
+}
+
+
+// attack cache task: render the attack of the next step in the background, a block at a time
+// returns true if some rendering has been done
+bool cache_task (void)
+{
+	AudioChannel* voices;
+
+	// the cache is not used while recording or replaying
+	if (rec_mode != REC_OFF) return false;
+	if (!attack_cached ()) {
+		// next step has changed: start again with the new one, once the cache is not played anymore
+		voices = attack_cache_arm ();
+		if (voices == NULL) return false;
+		set_voices (voices, &next_step);
+		next_attack_key (&cached_key);
+		return true;
+	}
+	return attack_cache_render ();
+}
+
+
+// no sound at all: no voice playing, and the reverb tail of the effect bus has died out
+bool is_silent (void)
+{
+	return !is_audio_playing () && fx_silent ();
+}
+
+
+// persist task: save song, position and instrument offset in flash, once they have not changed for some time
+// returns true if flash has been written
+bool persist_task (void)
+{
+	struct persist_state state;
+	uint64_t now;
+
+	now = time_us_64 ();
+	state.song_num = song_num;
+	state.step = next_step_number;
+	state.instr_offset = instr_offset;
+	if (memcmp (&state, &pending_state, sizeof (state)) != 0) {
+		memcpy (&pending_state, &state, sizeof (state));
+		pending_time = now;
+	}
+
+	// erasing the spare flash sector stops everything for tens of msec: only do it when no sound is played
+	if (presets_pending () && is_silent ()) {
+		printf ("Presets stored in flash\r\n");
+		return presets_store ();
+	}
+	if (persist_erase && is_silent ()) {
+		persist_erase = false;
+		return persist_prepare ();
+	}
 
+	// save state when it is stable: a page program is short enough to be done while playing, only the sector erase waits for silence
+	if (memcmp (&pending_state, &saved_state, sizeof (state)) == 0) return false;
+	if ((now - pending_time) < PERSIST_DELAY) return false;
+	if (!persist_save (&pending_state)) {
+		printf ("Could not save state in flash: no free record\n");
+		persist_erase = true;
+		return false;
+	}
+	memcpy (&saved_state, &pending_state, sizeof (state));
+	persist_erase = true;
+	return true;
+}
+
+
+// render load of the audio buffers, in % of the buffer duration
+uint32_t load_percent (uint32_t render_us, struct audio_load* load)
+{
+	return load->period_us ? (render_us * 100) / load->period_us : 0;
+}
+
+
+// print cpu load of the audio rendering over stdio
+void load_report (struct audio_load* load)
+{
+	uint32_t average = load->buffers ? (uint32_t) (load->total_us / load->buffers) : 0;
+
+	printf ("Audio load at %lu Hz: last %lu%%, average %lu%%, peak %lu%% (%lu us of %lu us), headroom %lu%%, underruns %lu\r\n",
+		(unsigned long) synth::sample_rate, (unsigned long) load_percent (load->last_us, load), (unsigned long) load_percent (average, load),
+		(unsigned long) load_percent (load->peak_us, load), (unsigned long) load->peak_us, (unsigned long) load->period_us,
+		(unsigned long) ((load->peak_us < load->period_us) ? 100 - load_percent (load->peak_us, load) : 0), (unsigned long) audio_underruns);
+}
+
+
+// render load at boot, at the sample rate of this build: time to render a buffer with all the voices playing
+// the voices play the first presets, into a block sized scratch buffer: nothing is heard. It is done once the song
+// is loaded, so as not to delay it, and the voices are then given back to the song as load_song () set them
+void boot_load_report (void)
+{
+	int16_t out [SYNTH_BLOCK * synth::output_channels];
+	int16_t send [SYNTH_BLOCK];
+	const Instrument* instrument;
+	uint32_t start, render_us, period_us;
+	int i, nb_chan, nb_step;
+
+	for (i = 0; i < CHANNEL_COUNT; i++) {
+		instrument = preset_instrument (i % NB_INSTRUMENTS);
+		if (instrument == NULL) continue;
+		channels [i].set_instrument (*instrument);
+		channels [i].frequency = 110 + (i * 37);
+		channels [i].trigger_attack ();
+	}
+	start = time_us_32 ();
+	for (i = 0; i < (BOOT_LOAD_BUFFERS * SAMPLES_PER_BUFFER) / SYNTH_BLOCK; i++) synth::render (out, send, SYNTH_BLOCK);
+	render_us = (time_us_32 () - start) / BOOT_LOAD_BUFFERS;
+
+	synth::reset_voices ();
+	for (i = 0; i < CHANNEL_COUNT; i++) channels [i] = AudioChannel ();
+	if (get_song_info (song_num, &nb_chan, &nb_step)) {
+		for (i = 0; i < nb_chan; i++) load_instrument (channel_instruments [i], i);
+		pan_channels (nb_chan);
+	}
+
+	period_us = (SAMPLES_PER_BUFFER * 1000000) / synth::sample_rate;
+	printf ("Audio: %d voices render in %lu us of %lu us per buffer at %lu Hz (%lu%%)\r\n", CHANNEL_COUNT, (unsigned long) render_us,
+		(unsigned long) period_us, (unsigned long) synth::sample_rate, (unsigned long) ((render_us * 100) / period_us));
+}
+
+
+// meter task: show peak cpu load of the audio rendering over the last window as a bar on the launchpad top row
+// green up to 50%, amber up to 75%, red beyond; only the leds that change are sent
+// returns true if the meter has been updated
+bool meter_task (void)
+{
+	int i;
+	uint32_t peak, lit;
+	uint8_t color;
+	bool busy = false;
+
+	if (meter_load.buffers == 0) return false;
+
+	// add window to the total, for the "load" console command
+	peak = load_percent (meter_load.peak_us, &meter_load);
+	total_load.last_us = meter_load.last_us;
+	if (meter_load.peak_us > total_load.peak_us) total_load.peak_us = meter_load.peak_us;
+	total_load.total_us += meter_load.total_us;
+	total_load.buffers += meter_load.buffers;
+	if (peak >= METER_WARNING) load_report (&meter_load);
+
+	// number of leds lit; any load lights the first led
+	lit = ((peak * METER_LEDS) + 99) / 100;
+	for (i = 0; i < METER_LEDS; i++) {
+		color = 0;
+		if ((uint32_t) i < lit) {
+			if (i < METER_LEDS / 2) color = 0x3C;				// green
+			else if (i < (METER_LEDS * 3) / 4) color = 0x3F;	// amber
+			else color = 0x0F;									// red
+		}
+		if (color != meter_shown [i]) {
+			// control change on the launchpad top row
+			queue_midi (ROLE_UI, 0xB0, METER_CC + i, color);
+			meter_shown [i] = color;
+			busy = true;
+		}
+	}
+
+	// start a new window
+	meter_load.peak_us = 0;
+	meter_load.total_us = 0;
+	meter_load.buffers = 0;
+	return busy;
+}
+
+
+// start recording or replaying a show: both start from the same song, position, instruments, presets and voices
+void show_start (bool replay)
+{
+	struct rec_start start;
+	uint8_t message [PRESET_SYSEX_MAX];
+	uint16_t length;
+	int i;
+
+	if (!RECORDER_ENABLED) {
+		printf ("Show recorder not compiled in (RECORDER option)\r\n");
+		return;
+	}
+	if (replay) {
+		if (!rec_replay (&start)) {
+			printf ("Nothing to replay\r\n");
+			return;
+		}
+		song_num = start.song_num;
+		instr_offset = start.instr_offset;
+		transpose = start.transpose;
+	}
+	else {
+		rec_stop ();
+		start.song_num = song_num;
+		start.step = next_step_number;
+		start.instr_offset = instr_offset;
+		start.transpose = transpose;
+	}
+
+	load = false;
+	load_pressed = load_unpressed = instr_pressed = false;
+	setlist_pos = setlist_find (song_num);
+	if (!load_song (song_num) || !set_position (start.step, true)) error ();
+	attack_cache_clear ();
+	reset_voices ();
+	replay_sysex.length = 0;
+	if (replay) return;
+
+	// presets are logged first, as the SysEx messages which set them from the built-in ones:
+	// the replay sets them back at its first frame, whatever they are by then
+	rec_record (&start);
+	length = preset_message (NB_INSTRUMENTS, message);
+	rec_sysex (message, length);
+	for (i = 0; i < NB_INSTRUMENTS; i++) {
+		length = preset_message (i, message);
+		if (length) rec_sysex (message, length);
+	}
+}
+
+
+// run a command typed on the stdio console
+
+
+void console_command (char* command)
+{
+	if (strcmp (command, "trace") == 0) trace_dump_start ();
+	else if (strcmp (command, "rec") == 0) show_start (false);
+	else if (strcmp (command, "replay") == 0) show_start (true);
+	else if (strcmp (command, "stop") == 0) rec_stop ();
+	else if (strcmp (command, "dump") == 0) rec_dump_start ();
+	else if (strcmp (command, "upload") == 0) rec_load_start ();
+	else if (strcmp (command, "tasks") == 0) sched_report ();
+	else if (strcmp (command, "load") == 0) {
+		load_report (&total_load);
+		fx_report ();
+		total_load.peak_us = 0;
+		total_load.total_us = 0;
+		total_load.buffers = 0;
+	}
+	else if (command [0] != 0) printf ("Commands: trace (dump trace ring), tasks (task report), load (audio and effects cpu load), "
+		"rec / replay / stop (show recorder), dump / upload (recorder log)\r\n");
+}
+
+
+// console task: read a command line from stdio, without waiting, and print trace dumps
+// returns true if a character has been read or printed
+bool console_task (void)
+{
+	static char line [CONSOLE_LG];		// command line being typed
+	static int length = 0;
+	int c;
+
+	// a trace or recorder dump is going on: one record at a time
+	if (trace_dump_next ()) return true;
+	if (rec_dump_next ()) return true;
+
+	c = getchar_timeout_us (0);
+	if (c == PICO_ERROR_TIMEOUT) return false;
+
+	if ((c == '\r') || (c == '\n')) {
+		line [length] = 0;
+		// recorder log being uploaded: lines are records
+		if (rec_loading ()) rec_load_line (line);
+		else console_command (line);
+		length = 0;
+	}
+	else if (length < CONSOLE_LG - 1) line [length++] = c;
+	return true;
+}
+
+
+// main loop tasks, by priority order: audio first, then input, MIDI RX, MIDI TX, led repaint, preload of next song, save of state in flash, cpu load meter and console
+static struct sched_task tasks [] = {
+	// name, function, period in usec (0: polled), budget in cycles
+	{"audio", audio_task, 0, SCHED_US_TO_CYCLES (4000)},
+	{"input", input_task, 0, SCHED_US_TO_CYCLES (200)},
+	{"midi rx", midi_rx_task, 0, SCHED_US_TO_CYCLES (500)},
+	{"midi tx", midi_tx_task, 0, SCHED_US_TO_CYCLES (300)},
+	{"leds", led_task, 0, SCHED_US_TO_CYCLES (1000)},
+	{"preload", preload_task, 0, SCHED_US_TO_CYCLES (1000)},
+#if ATTACK_CACHE_MS
+	{"cache", cache_task, 0, SCHED_US_TO_CYCLES (1000)},
+#endif
+	{"persist", persist_task, 10000, SCHED_US_TO_CYCLES (1000)},
+	{"meter", meter_task, METER_WINDOW, SCHED_US_TO_CYCLES (3000)},
+	{"console", console_task, 5000, SCHED_US_TO_CYCLES (3000)},
+};
+
+
+int main() {
+	bool restored;
+	uint32_t time_restored, time_init, time_loaded;
+	int role;
 
 	stdio_init_all();
 	board_init();
 	printf("Picopanion\r\n");
 
+	// runtime buffers, from the startup arena: before anything can use them
+	arena_init (arena_ram, arena_budgets);
+	midi_rx = (uint8_t *) arena_take (ARENA_MIDI, RX_LG);
+	for (role = 0; role < MIDI_ROLES; role++) {
+		midi_devices [role].tx = new (arena_take (ARENA_MIDI, sizeof (*midi_devices [role].tx))) spsc_ring<struct midisend, MIDI_TX_LG>;
+	}
+	trace_init ();
+	rec_init ();
+	attack_cache_init ();
+
+	// restore last song, position and instrument from flash, before USB enumeration: pedals can play as soon as the song is loaded
+	restored = persist_restore (&saved_state);
+	if (restored) {
+		song_num = saved_state.song_num;
+		instr_offset = saved_state.instr_offset;
+	}
+	memcpy (&pending_state, &saved_state, sizeof (pending_state));
+	// instrument presets, from flash or built-in
+	presets_init ();
+	memset (external_notes, NO_NOTE, sizeof (external_notes));
+	time_restored = time_us_32 ();
+
 	// configure USB host
 	tusb_init();
 
 	// configure audio
-	struct audio_buffer_pool *ap = init_audio(synth::sample_rate, PICO_AUDIO_PACK_I2S_DATA, PICO_AUDIO_PACK_I2S_BCLK);
+	ap = init_audio(synth::sample_rate, PICO_AUDIO_PACK_I2S_DATA, PICO_AUDIO_PACK_I2S_BCLK);
+	meter_load.period_us = (SAMPLES_PER_BUFFER * 1000000) / synth::sample_rate;
+	total_load.period_us = meter_load.period_us;
+	// latency from a press to its sound is at most the queued buffers, plus the one being rendered and the limiter lookahead
+	printf ("Audio: %lu Hz, %d buffers of %d frames, latency %lu us\r\n", (unsigned long) synth::sample_rate, AUDIO_BUFFERS, SAMPLES_PER_BUFFER,
+		(unsigned long) (((AUDIO_BUFFERS + 1) * meter_load.period_us) + ((LIMITER_LOOKAHEAD * 1000000) / synth::sample_rate)));
+	// build percussion one-shots
+	init_percussion ((int16_t *) arena_take (ARENA_PERCUSSION, arena_budgets [ARENA_PERCUSSION]));
+	// effect bus on core 1
+	fx_init ();
+	// RAM map, once the audio buffer pool is allocated
+	arena_report ();
 
 	// Map the pins to functions
 	gpio_init(LED_GPIO);
@@ -574,130 +1728,43 @@ int main() {
 	gpio_set_dir(SWITCH_3, GPIO_IN);
 	gpio_pull_up (SWITCH_3);		 // switch pull-up
 
+	// capture switch edges by interrupt, on press and on release
+	gpio_set_irq_enabled_with_callback (SWITCH_1, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &pedal_irq);
+	gpio_set_irq_enabled (SWITCH_2, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+	gpio_set_irq_enabled (SWITCH_3, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+
 	// init pedal structure to all 0
 	pedal.value = 0;
 	pedal.change_state = false;
 	pedal.change_value = 0;
 	pedal.change_time = 0;
+	pedal.time = 0;
 
-	// load song 000 by default, and set green leds for load button and reset position button
-	// set all the leds, load next step, set next step to #0
-	number_of_songs = song [0];
-	if (!load_song (song_num)) error ();
-
-
-	// main loop
-	while (true) {
-
-		tuh_task();
-		// check connection to USB slave
-		connected = ((midi_dev_addr != 0) && tuh_midi_configured(midi_dev_addr));
-
-		// test pedal and check if one of them is pressed
-		test_switch (S1 | S2 | RESET, &pedal);
-
-		// check if state has changed, ie. pedal has just been pressed or unpressed
-		if (pedal.change_state) {
-
-			// play a sound
-			if ((pedal.value == S1) || (pedal.value == S2)) {
-
-				// in case next_switch value is undetermined, force this press as being "next"
-				if (next_switch == 0) next_switch = pedal.value;
-
-				// assign current step to temp variable : this is the pad we are going to "play" if next switch has not been pressed
-				memcpy (&temp_step, &cur_step, sizeof (struct songstep));
-				
-				// test if we pressed "next" switch, ie. the switch that makes us move to next step in the song
-				if (pedal.value == next_switch) {
-					// we have pressed "next step"
-					// for safety, copy "next step" values in "temp" 
-					memcpy (&temp_step, &next_step, sizeof (struct songstep));
-					// color of "next step" pad shall be set back to normal
-					set_led (&temp_step);
-					// determine next step in the song
-					if (++next_step_number >= temp_step.number_of_steps) next_step_number = 0;
-					// load new next step structure
-					if (!get_step (song_num, next_step_number, &next_step)) error ();
-					// set led color of next step in a nice green
-					set_green_led (&next_step);
-					// assign next pedal/switch that should be pressed to have "next" step the next time
-					next_switch = ((pedal.value == S1) ? S2 : S1);
-				}
-				
-				// no need to stop previous sound as:
-				// 1- whenever playing new sound stops previous sound on the same channel
-				// 2- whether having 0 as new sound frequency stops sound in the same channel
-
-				// temp step is becoming the current step: fill pad structure
-				// the trick here is that temp is either set as current step (in case no next switch has been pressed), or at next step (if next step switch has been pressed)
-				memcpy (&cur_step, &temp_step, sizeof (struct songstep));
-				// play new sound
-				update_playback (&cur_step);
-			}
-
-			// if pedal has been released, then stop playback
-			if (pedal.value == 0) {
-				stop_playback ();
-			}
-
-			// check if RESET_POS pedal switch has been pressed for more than 2 sec
-			if ((pedal.value == 0) && (pedal.change_value & RESET)) {
-				// no pedal pressed anymore and pedal previously pressed was RESET
-				// check how much time the previous pedal was pressed; if more than 2 sec, then reset position to 0 in the song
-				if (pedal.change_time >= EXIT_FUNCTION) {
-					reset_position (true);			// reset position in the song to 0
-					reset_playback ();
-				}
-			}
-		}
-
-
-		// load functionality
-		if (load_pressed) {			// load pad has just been pressed
-			reset_leds ();			// clear leds and light function leds
-			// set leds on , according to the number of songs
-			k = 0;
-			while (k < number_of_songs) {		// load mode : set existing songs as green buttons (green pads)
-
-				i = k / 8;
-				j = k % 8;
-				temp_step.pad_number = (i * 0x10) + j;		// set song button to green
-				set_green_led (&temp_step);
-				
-				k++;
-			}
-			load_pressed = false;
-			load = true;
-		}
-		if (load_unpressed) {							// load pad has just been unpressed
-			load = false;
-			load_unpressed = false;
-			instr_offset = 0;							// song will be loaded with initial instruments
-			if (!load_song (song_num)) error ();		// load new song according to song_num
-		}
-
-		// change instrument functionality
-		if (instr_pressed) {			// change instr pad has just been pressed
-			instr_offset++;				// increase instrument offset to change to next instr
-			if (!load_song (song_num)) error ();		// load current song again to reload the instruments
-			instr_pressed = false;
-		}
-
-		// in case some MIDI data is to be sent, then send it
-		if (index_tx) {
-//			if (!send_midi ()) printf ("Could not send midi out, %d midi events in buffer\n", index_tx);
-			send_midi ();
-		}
+	time_init = time_us_32 ();
 
+	// load last song (song 000 by default), and set green leds for load button and reset position button
+	// set all the leds, load next step, set next step to last position (#0 by default)
+	number_of_songs = song_count ();
+	if (song_num >= number_of_songs) {
+		song_num = 0;
+		instr_offset = 0;
+		restored = false;
+	}
+	setlist_pos = setlist_find (song_num);
+	if (!load_song (song_num)) error ();
+	else if (restored && !set_position (saved_state.step, true)) reset_position (true);
+	time_loaded = time_us_32 ();
 
-		// read MIDI events coming from groovebox and manage accordingly
-		if (connected) tuh_midi_stream_flush(midi_dev_addr);
+	// boot timing: from power-up to the first sound the pedals can play
+	printf ("Boot: state %s at %lu us, init done at %lu us, song %d step %d playable at %lu us\n", (restored ? "restored" : "not found"),
+		(unsigned long) time_restored, (unsigned long) time_init, song_num, next_step_number, (unsigned long) time_loaded);
+	// cpu load of the voices at this sample rate, once the song is playable
+	boot_load_report ();
 
 
-    	// update audio buffer : make sure we do this regularly (in while loop)
-	   	update_buffer(ap, get_audio_frame);
-	}
+	// main loop
+	sched_init (tasks, sizeof (tasks) / sizeof (tasks [0]));
+	sched_run ();
 }
 
 
@@ -712,45 +1779,82 @@ int main() {
 // therefore report_desc = NULL, desc_len = 0
 void tuh_midi_mount_cb(uint8_t dev_addr, uint8_t in_ep, uint8_t out_ep, uint8_t num_cables_rx, uint16_t num_cables_tx)
 {
+	static const char* role_names [MIDI_ROLES] = {"UI", "control surface", "keyboard"};
+	uint16_t vid = 0, pid = 0;
+	int role;
+	uint8_t shown [LED_FRAME];
+	struct midisend stale;
+
 	printf("MIDI device address = %u, IN endpoint %u has %u cables, OUT endpoint %u has %u cables\r\n",
 		dev_addr, in_ep & 0xf, num_cables_rx, out_ep & 0xf, num_cables_tx);
 
-	if (midi_dev_addr == 0) {
-		// then no MIDI device is currently connected
-		midi_dev_addr = dev_addr;
-	}
+	// role of the device: novation devices are the UI (first one) or a control surface,
+	// other devices are the keyboard (first one) or a control surface
+	tuh_vid_pid_get (dev_addr, &vid, &pid);
+	if (vid == NOVATION_VID) role = (midi_devices [ROLE_UI].addr == 0) ? ROLE_UI : ROLE_CONTROL;
+	else role = (midi_devices [ROLE_KEYBOARD].addr == 0) ? ROLE_KEYBOARD : ROLE_CONTROL;
 
-	else {
-		printf("A different USB MIDI Device is already connected.\r\nOnly one device at a time is supported in this program\r\nDevice is disabled\r\n");
+	if (midi_devices [role].addr != 0) {
+		printf("MIDI device %04x:%04x: a %s is already connected\r\nDevice is disabled\r\n", vid, pid, role_names [role]);
+		return;
+	}
+	midi_devices [role].addr = dev_addr;
+	midi_parser_reset (&midi_devices [role].parser);
+	// events queued while no device had this role are dropped
+	while (midi_devices [role].tx->pop (stale));
+	printf("MIDI device %04x:%04x is the %s\r\n", vid, pid, role_names [role]);
+
+	// new launchpad: repaint all its leds from the ones we have set so far
+	if (role == ROLE_UI) {
+		memcpy (shown, led_shown, sizeof (shown));
+		reset_launchpad ();
+		commit_leds (shown);
 	}
 }
 
 // Invoked when device with hid interface is un-mounted
 void tuh_midi_umount_cb(uint8_t dev_addr, uint8_t instance)
 {
-	if (dev_addr == midi_dev_addr) {
-		midi_dev_addr = 0;
-		printf("MIDI device address = %d, instance = %d is unmounted\r\n", dev_addr, instance);
-	}
-	else {
-		printf("Unused MIDI device address = %d, instance = %d is unmounted\r\n", dev_addr, instance);
+	int i;
+
+	for (i = 0; i < MIDI_ROLES; i++) {
+		if (dev_addr == midi_devices [i].addr) {
+			midi_devices [i].addr = 0;
+			midi_devices [i].connected = false;
+			printf("MIDI device address = %d, instance = %d is unmounted\r\n", dev_addr, instance);
+			return;
+		}
 	}
+	printf("Unused MIDI device address = %d, instance = %d is unmounted\r\n", dev_addr, instance);
 }
 
 // invoked when receiving some MIDI data
+// the callback only decodes midi data into events; events are processed by the main loop (see process_midi_event ())
 void tuh_midi_rx_cb(uint8_t dev_addr, uint32_t num_packets)
 {
 	uint8_t cable_num;
 	uint8_t *buffer;
-	uint8_t j, k, l;
 	uint32_t i;
 	uint32_t bytes_read;
-	struct songstep temp_step;
+	struct midi_message msg;
+	struct midi_event event;
+	struct midi_sysex sysex;
+	struct midi_device* device = NULL;
+	midi_parse_result result;
+	int role;
 
 	// set midi_rx as buffer
 	buffer = midi_rx;
+
+	// device the data comes from
+	for (role = 0; role < MIDI_ROLES; role++) {
+		if (midi_devices [role].addr == dev_addr) {
+			device = &midi_devices [role];
+			break;
+		}
+	}
 	
-	if (midi_dev_addr == dev_addr)
+	if (device != NULL)
 	{
 		if (num_packets != 0)
 		{
@@ -758,102 +1862,55 @@ void tuh_midi_rx_cb(uint8_t dev_addr, uint32_t num_packets)
 				bytes_read = tuh_midi_stream_read(dev_addr, &cable_num, buffer, RX_LG);
 				if (bytes_read == 0) return;
 				if (cable_num == 0) {
-					i = 0;
-					while (i < bytes_read) {
+					event.time = time_us_32 ();
+					event.role = role;
+					// parse the stream byte per byte: messages may be split across reads, and may use running status
+					for (i = 0; i < bytes_read; i++) {
+						result = midi_parse_byte (&device->parser, buffer [i], &msg);
+						// SysEx messages: preset changes, handled by the main loop
+						if ((result == MIDI_SYSEX) && !device->parser.sysex_overflow) {
+							sysex.length = device->parser.sysex_length;
+							memcpy (sysex.data, device->parser.sysex, sysex.length);
+							midi_sysex_messages.push (sysex);
+						}
+						if (result != MIDI_MESSAGE) continue;
+						TRACE (TRACE_MIDI_RX, msg.status, msg.data [0] | (msg.data [1] << 8));
 						// test values received from midi surface control via MIDI protocol
-						switch (buffer [i] & 0xF0) {	// control only most significant nibble to increment index in buffer; event sorting is approximative, but should be enough
+						switch (msg.status & 0xF0) {
 							case 0x90:	// note on
-								// Would it be useful to put this in the main loop rather than in this callback ?
-
-								// test velocity : if velocity is 0, then pad is released on the launchpad
-								if (buffer[i+2] == 0) {
-									// if pad release is the same number as the last pad that was pressed, then sound off
-									if (buffer [i+1] == cur_step.pad_number) stop_playback ();
-									// if load button is unpressed, then set relevant state
-									if (buffer [i+1] == LOAD) load_unpressed = true;
-
-									i+=3;
+								// keyboard: only key presses are used
+								if (role == ROLE_KEYBOARD) {
+									if (msg.data [1] == 0) break;
+									event.type = KEY_PRESSED;
+									event.pad = msg.data [0];
+									event.value = msg.data [1];
+									midi_events.push (event);
 									break;
 								}
-								
-								// else velocity is 0x7F: pad is pressed on launchpad
-								// reset position functionality
-								if (buffer[i+1] == RESET_POS) {
-									reset_position (true);
-									reset_playback ();
-									i+=3;
-									break;
-								}
-
-								// change instrumentfunctionality
-								if (buffer[i+1] == CHANGE_INSTRUMENT) {
-									instr_pressed = true;
-									reset_playback ();
-									i+=3;
-									break;
-								}
-
-								// load functionality
-								if (buffer[i+1] == LOAD) {
-									load_pressed = true;
-									reset_playback ();
-									i+=3;
-									break;
-								}
-								if (load) {								// we are in load functionality
-									j = buffer [i+1] & 0x0F;			// determine which song has been pressed according to pad number: low nibble
-									k = (buffer [i+1] >> 4) & 0x0F;		// high nibble
-									if ((j < 8) && (k < 8)) {			// test boundaries of selected pad, to see if this corresponds to an existing song
-										l = (k * 8) + j;
-										if (l < number_of_songs) song_num = l;	// set song_number with the new value (ie. pad number of pad which has been pressed)
-									}
-									i+=3;
-									break;
-								}
-
-								// determine if the pressed pad is assigned to a step, and which step; we start checking the pads from next_step_number
-								// to make sure we don't miss the next step
-								if (!get_step_from_pad_number (song_num, next_step_number, buffer [i+1], &temp_step)) error ();
-								else {
-									// we have pressed a pad that is assigned to a step
-									if (temp_step.pad_number == next_step.pad_number) {
-										// we have pressed the "next step" pad; for safety, copy "next step" values in "temp" 
-										memcpy (&temp_step, &next_step, sizeof (struct songstep));
-										// color of "next step" pad shall be set back to normal
-										set_led (&temp_step);
-										// determine next step in the song
-										if (++next_step_number >= temp_step.number_of_steps) next_step_number = 0;
-										// load new next step structure
-										if (!get_step (song_num, next_step_number, &next_step)) error ();
-										// set led color of next step in a nice green
-										set_green_led (&next_step);
-									}
-									// no need to stop previous sound as:
-									// 1- whenever playing new sound stops previous sound on the same channel
-									// 2- whether having 0 as new sound frequency stops sound in the same channel
-
-									// pressed pad is becoming the current pad: fill pad structure
-									memcpy (&cur_step, &temp_step, sizeof (struct songstep));
-									// play new sound
-									update_playback (&cur_step);
-								}
-								i+=3;
+								// test velocity : if velocity is 0, then pad is released on the launchpad
+								event.type = (msg.data [1] == 0) ? PAD_RELEASED : PAD_PRESSED;
+								event.pad = msg.data [0];
+								event.value = msg.data [1];
+								midi_events.push (event);
 								break;
 							case 0x80:	//note off
-							case 0xA0:
-							case 0xB0:
-							case 0xE0:
-								i+=3;
-								break;
-							case 0xC0:
-							case 0xD0:
-								i+=2;
+								if (role == ROLE_KEYBOARD) break;
+								event.type = PAD_RELEASED;
+								event.pad = msg.data [0];
+								event.value = 0;
+								midi_events.push (event);
 								break;
-							case 0xF0:
-								i+=1;
+							case 0xF0:	// system messages: only the clock is used
+								if (msg.status == 0xF8) event.type = CLOCK_TICK;
+								else if (msg.status == 0xFA) event.type = CLOCK_START;
+								else if (msg.status == 0xFB) event.type = CLOCK_CONTINUE;
+								else if (msg.status == 0xFC) event.type = CLOCK_STOP;
+								else break;
+								event.pad = 0;
+								event.value = 0;
+								midi_events.push (event);
 								break;
 							default:
-								i+=1;
 								break;
 						}
 					}
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+#include "presets.hpp"
+#include "persist.hpp"
+#include "fx.hpp"
+
+using namespace synth;
+
+// presets as stored in flash: a header then the presets, in the first pages of the sector
+struct preset_block {
+  uint32_t magic;                 // PRESET_MAGIC for valid presets
+  uint16_t version;               // PRESET_VERSION of the firmware which stored them
+  uint16_t count;                 // number of presets
+  uint32_t check;                 // check value of the presets
+  struct preset presets[NB_INSTRUMENTS];
+};
+
+#define PRESET_MAGIC        0x54455250    // "PRET"
+#define PRESET_OFFSET       (PICO_FLASH_SIZE_BYTES - ((PERSIST_SECTORS + 1) * FLASH_SECTOR_SIZE))
+#define PRESET_FIELDS       15            // fields of a preset set by SysEx
+#define PRESET_MIN_FIELDS   8             // fields after cutoff may be left out
+#define PRESET_PAGES        ((sizeof(struct preset_block) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE)
+#define PRESET_ROUTE_BITS   (PRESET_EXTERNAL | PRESET_DRUMS | 0x0300 | 0x000F)   // bits of an external route: flags, role, channel
+
+#define SYSEX_SET           0x01
+#define SYSEX_STORE         0x02
+#define SYSEX_RESET         0x03
+
+static_assert(sizeof(struct preset) == 32, "preset must be 32 bytes");
+static_assert(sizeof(struct preset_block) <= FLASH_SECTOR_SIZE, "presets must fit in a flash sector");
+static_assert(5 + (PRESET_FIELDS * 3) == PRESET_SYSEX_MAX, "a set SysEx message has 3 bytes per field");
+
+// 0: piano
+// 1: piano2
+// 2: reed
+// 3: guitar
+// 4: pluckedguitar
+// 5: bass
+// 6: violin
+// 7: horn
+// 8: oboe
+// 9: clarinette
+// 10: flute
+// 11: drums (percussion one-shots: kick, snare, hat)
+
+// waveform, attack in ms, decay in ms, sustain volume (0xafff = 70% of max volume), sustain in ms,
+// release in ms, channel volume (up to 0xffff; peaks of the mix are brought under full scale by the master limiter),
+// filter cutoff, route, effect send, vibrato rate (0.1 Hz) and depth (cents), tremolo rate (0.1 Hz) and depth,
+// filter envelope (Hz)
+static const struct preset default_presets[NB_INSTRUMENTS] = {
+  {Waveform::PIANO, 30, 20, 0xafff, 2000, 1000, 24000, 0, 0, 0x3000, 0, 0, 0, 0, 0},
+  {Waveform::PIANO2, 30, 20, 0xafff, 2000, 1000, 24000, 0, 0, 0x3000, 0, 0, 0, 0, 0},
+  {Waveform::REED, 30, 20, 0xafff, 2000, 1000, 24000, 0, 0, 0x3000, 0, 0, 0, 0, 0},
+  {Waveform::GUITAR, 10, 10, 0xafff, 1000, 500, 24000, 0, 0, 0x3000, 0, 0, 0, 0, 0},
+  {Waveform::PLUCKEDGUITAR, 10, 10, 0xafff, 1000, 500, 24000, 0, 0, 0x3000, 0, 0, 0, 0, 0},
+  {Waveform::SQUARE, 10, 10, 0xafff, 1000, 500, 12000, 0, 0, 0, 0, 0, 0, 0, 0},
+  {Waveform::VIOLIN, 50, 200, 0xafff, 500, 5000, 24000, 0, 0, 0x4000, 55, 15, 0, 0, 0},
+  {Waveform::HORN, 120, 50, 0xafff, 2000, 100, 24000, 0, 0, 0x4000, 45, 8, 0, 0, 0},
+  {Waveform::OBOE, 120, 50, 0xafff, 2000, 100, 24000, 0, 0, 0x4000, 0, 0, 0, 0, 0},
+  {Waveform::CLARINETTE, 120, 50, 0xafff, 2000, 100, 24000, 0, 0, 0x4000, 0, 0, 0, 0, 0},
+  {Waveform::FLUTE, 120, 50, 0xafff, 2000, 100, 24000, 0, 0, 0x4000, 50, 10, 50, 0x1000, 0},
+  {Waveform::PERCUSSION, 0, 0, 0, 0, 0, 38000, 0, 0, 0x1000, 0, 0, 0, 0, 0}        // one-shots have their own envelope: only channel volume is used
+
+//  {Waveform::TRIANGLE | Waveform::SQUARE, 16, 168, 0xafff, 10000, 168, 10000, 0, 0, 0, 0, 0, 0, 0, 0},   //melody
+//  {Waveform::SINE | Waveform::SQUARE, 38, 300, 0, 0, 0, 12000, 0, 0, 0, 0, 0, 0, 0, 0},                  //rhythm
+//  {Waveform::NOISE, 5, 10, 16000, 10000, 100, 18000, 0, 0, 0, 0, 0, 0, 0, 0},                            //drum
+//  {Waveform::NOISE, 5, 5, 8000, 10000, 40, 8000, 0, 0, 0, 0, 0, 0, 0, 0},                                //hihat
+//  {Waveform::SQUARE, 10, 100, 0, 0, 500, 12000, 0, 0, 0, 0, 0, 0, 0, 0},                                 //bass
+};
+
+static struct preset_block block;                                 // current presets, as they would be stored
+static Instrument instruments[NB_INSTRUMENTS];                    // current presets, compiled
+static bool valid[NB_INSTRUMENTS];                                // preset can be played by this firmware
+static int16_t wavetables[NB_INSTRUMENTS][WAVETABLE_SIZE];        // mixed waveforms of each preset
+static bool pending = false;                                      // presets to be stored in flash (SysEx store)
+
+
+static uint32_t check_of(const struct preset_block *presets) {
+  const uint32_t *words = (const uint32_t *) presets->presets;
+  uint32_t check = presets->magic ^ (uint32_t(presets->version) << 16) ^ presets->count;
+  for(uint32_t i = 0; i < sizeof(presets->presets) / 4; i++) {
+    check = (check * 2654435761u) ^ words[i];
+  }
+  return check;
+}
+
+
+// derive the instrument played from a preset; returns false if this firmware cannot play it
+static bool compile(int number, const struct preset *preset) {
+  Instrument *instrument = &instruments[number];
+  uint32_t waveforms = preset->waveforms;
+
+  // parts played by a midi device: the voices have nothing to play
+  if(preset->route & PRESET_EXTERNAL) {
+    if(preset->route & ~PRESET_ROUTE_BITS) return false;
+    if(PRESET_ROLE(preset->route) >= PRESET_ROLES) return false;
+    *instrument = Instrument();
+    instrument->waveforms = 0;
+    return true;
+  }
+  if(preset->route != PRESET_INTERNAL) return false;
+
+  // several waveforms are mixed once into a wavetable, rather than at each sample
+  bool mixed = (waveforms & (waveforms - 1)) && ((waveforms & ~TABLE_WAVEFORMS) == 0);
+  if(mixed) waveforms = Waveform::TABLE;
+  if((waveforms == 0) || !Engine::supports(waveforms)) return false;
+  // WAVE plays a buffer filled by a callback of the firmware, which a preset cannot give
+  if(waveforms & Waveform::WAVE) return false;
+  // percussion one-shots cannot be mixed with other waveforms (see trigger_attack)
+  if((waveforms & Waveform::PERCUSSION) && (waveforms != Waveform::PERCUSSION)) return false;
+  if(preset->vibrato_depth > PRESET_VIBRATO_MAX) return false;
+  if(mixed) mix_wavetable(preset->waveforms, wavetables[number]);
+
+  instrument->waveforms = waveforms;
+  instrument->wavetable = mixed ? wavetables[number] : nullptr;
+  instrument->attack_frames = envelope_frames(preset->attack_ms);
+  instrument->decay_frames = envelope_frames(preset->decay_ms);
+  instrument->sustain = preset->sustain;
+  instrument->sustain_frames = envelope_frames(preset->sustain_ms);
+  instrument->release_frames = envelope_frames(preset->release_ms);
+  instrument->volume = preset->volume;
+  instrument->filter = lowpass_coefficient(preset->cutoff);
+  instrument->send = FX_ENABLED ? preset->send : 0;     // without the effect bus, a send mix would be rendered for nothing
+  instrument->vibrato_rate = lfo_increment(preset->vibrato_rate);
+  instrument->vibrato_depth = vibrato_ratio(preset->vibrato_depth);
+  instrument->tremolo_rate = lfo_increment(preset->tremolo_rate);
+  instrument->tremolo_depth = preset->tremolo_depth;
+  // the coefficient of the filter is raised rather than its cutoff, so that the envelope only costs an add
+  instrument->filter_env = preset->cutoff ? lowpass_coefficient(preset->cutoff + preset->filter_env) - instrument->filter : 0;
+  return true;
+}
+
+
+static void set_all(const struct preset *presets) {
+  for(int i = 0; i < NB_INSTRUMENTS; i++) {
+    block.presets[i] = presets[i];
+    valid[i] = compile(i, &presets[i]);
+  }
+}
+
+
+void presets_init(void) {
+  const struct preset_block *stored = (const struct preset_block *) (XIP_BASE + PRESET_OFFSET);
+
+  block.magic = PRESET_MAGIC;
+  block.version = PRESET_VERSION;
+  block.count = NB_INSTRUMENTS;
+
+  // presets stored by another version may not mean the same: built-in presets are used instead
+  if((stored->magic == PRESET_MAGIC) && (stored->version == PRESET_VERSION) && (stored->count == NB_INSTRUMENTS) &&
+     (stored->check == check_of(stored))) {
+    set_all(stored->presets);
+    printf("Presets loaded from flash\r\n");
+  }
+  else {
+    set_all(default_presets);
+  }
+  pending = false;
+}
+
+
+uint16_t preset_route(int number) {
+  if((number < 0) || (number >= NB_INSTRUMENTS) || !valid[number]) return PRESET_INTERNAL;
+  return block.presets[number].route;
+}
+
+
+const Instrument *preset_instrument(int number) {
+  if((number < 0) || (number >= NB_INSTRUMENTS) || !valid[number]) return nullptr;
+  return &instruments[number];
+}
+
+
+bool preset_set(int number, const struct preset *preset) {
+  if((number < 0) || (number >= NB_INSTRUMENTS)) return false;
+
+  // an invalid preset leaves the current one as it is
+  if(!compile(number, preset)) return false;
+  block.presets[number] = *preset;
+  valid[number] = true;
+  return true;
+}
+
+
+// field of a SysEx message: 3 bytes of 7 bits, least significant first
+static uint32_t sysex_field(const uint8_t *data) {
+  return (data[0] & 0x7f) | (uint32_t(data[1] & 0x7f) << 7) | (uint32_t(data[2] & 0x7f) << 14);
+}
+
+
+int preset_sysex(const uint8_t *data, uint16_t length) {
+  if((length < 3) || (data[0] != PRESET_SYSEX_ID) || (data[1] != PRESET_SYSEX_TAG)) return -1;
+
+  switch(data[2]) {
+    case SYSEX_SET: {
+      if((length < 5) || ((length - 5) % 3) || ((length - 5) / 3 < PRESET_MIN_FIELDS) || ((length - 5) / 3 > PRESET_FIELDS)) return -1;
+      int number = data[3];
+      if(data[4] != PRESET_VERSION) {
+        printf("Preset %d: version %u instead of %u\r\n", number, data[4], PRESET_VERSION);
+        return -1;
+      }
+      uint32_t field[PRESET_FIELDS] = {};
+      for(int i = 0; i < (length - 5) / 3; i++) field[i] = sysex_field(&data[5 + (i * 3)]);
+      // fields are 21 bits: a value which does not fit its field of struct preset rejects the whole message,
+      // rather than being truncated into another preset
+      int bad = (field[0] & ~ALL_WAVEFORMS) ? 0 : -1;
+      for(int i = 1; (i < PRESET_FIELDS) && (bad < 0); i++) {
+        if(field[i] > 0xffff) bad = i;
+      }
+      if(bad >= 0) {
+        printf("Preset %d: field %d out of range (%lu)\r\n", number, bad, (unsigned long) field[bad]);
+        return -1;
+      }
+      struct preset preset;
+      preset.waveforms = field[0];
+      preset.attack_ms = field[1];
+      preset.decay_ms = field[2];
+      preset.sustain = field[3];
+      preset.sustain_ms = field[4];
+      preset.release_ms = field[5];
+      preset.volume = field[6];
+      preset.cutoff = field[7];
+      preset.route = field[8];
+      preset.send = field[9];
+      preset.vibrato_rate = field[10];
+      preset.vibrato_depth = field[11];
+      preset.tremolo_rate = field[12];
+      preset.tremolo_depth = field[13];
+      preset.filter_env = field[14];
+      if(!preset_set(number, &preset)) {
+        printf("Preset %d: cannot be played\r\n", number);
+        return -1;
+      }
+      return number;
+    }
+    case SYSEX_STORE:
+      pending = true;
+      return -1;
+    case SYSEX_RESET:
+      set_all(default_presets);
+      return NB_INSTRUMENTS;
+    default:
+      return -1;
+  }
+}
+
+
+uint16_t preset_message(int number, uint8_t *data) {
+  data[0] = PRESET_SYSEX_ID;
+  data[1] = PRESET_SYSEX_TAG;
+  if(number == NB_INSTRUMENTS) {
+    data[2] = SYSEX_RESET;
+    return 3;
+  }
+  if((number < 0) || (number > NB_INSTRUMENTS)) return 0;
+  const struct preset *preset = &block.presets[number];
+  if(memcmp(preset, &default_presets[number], sizeof(struct preset)) == 0) return 0;
+
+  // fields in the order of struct preset, as preset_sysex() reads them
+  const uint32_t field[PRESET_FIELDS] = {preset->waveforms, preset->attack_ms, preset->decay_ms, preset->sustain,
+    preset->sustain_ms, preset->release_ms, preset->volume, preset->cutoff, preset->route, preset->send,
+    preset->vibrato_rate, preset->vibrato_depth, preset->tremolo_rate, preset->tremolo_depth, preset->filter_env};
+  data[2] = SYSEX_SET;
+  data[3] = number;
+  data[4] = PRESET_VERSION;
+  for(int i = 0; i < PRESET_FIELDS; i++) {
+    data[5 + (i * 3)] = field[i] & 0x7f;
+    data[6 + (i * 3)] = (field[i] >> 7) & 0x7f;
+    data[7 + (i * 3)] = (field[i] >> 14) & 0x7f;
+  }
+  return 5 + (PRESET_FIELDS * 3);
+}
+
+
+bool presets_pending(void) {
+  return pending;
+}
+
+
+bool presets_store(void) {
+  static uint8_t page[PRESET_PAGES * FLASH_PAGE_SIZE];
+
+  if(!pending) return false;
+  pending = false;
+  block.check = check_of(&block);
+  memset(page, 0xff, sizeof(page));
+  memcpy(page, &block, sizeof(block));
+
+  uint32_t interrupts = flash_write_begin();
+  flash_range_erase(PRESET_OFFSET, FLASH_SECTOR_SIZE);
+  flash_range_program(PRESET_OFFSET, page, sizeof(page));
+  flash_write_end(interrupts);
+  return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include "synth.hpp"
+#include "songdata.hpp"
+
+// instrument presets: what each instrument number of the songs sounds like
+//
+// Presets are kept in a flash sector (just before the persist sectors), and replaced by the built-in
+// defaults if there are none, or if they were saved with another PRESET_VERSION. They can be changed
+// live with SysEx messages (see preset_sysex), then stored in flash. Each preset is compiled once into
+// a synth::Instrument when it is set: waveforms mixed into a wavetable, envelope phases in frames,
+// filter coefficients and lfo increments, so that playing costs nothing more than with a built-in instrument.
+//
+// A preset may also route its parts to a midi device instead of the synth (see route): notes of the
+// channels playing it are then sent as NOTE ON / NOTE OFF, and their voices stay off.
+//
+// SysEx messages: F0 7D 50 command ... F7 (7D: non-commercial manufacturer id, 50: 'P')
+//   01 number version field*15  set preset number; each field is 3 bytes of 7 bits, least significant first,
+//                               in the order of struct preset (the fields after cutoff may be left out: they are then 0);
+//                               the whole message is rejected if a field is out of range, or the preset cannot be played
+//   02                          store presets in flash
+//   03                          back to the built-in presets
+
+#define PRESET_VERSION      3
+#define PRESET_SYSEX_ID     0x7D
+#define PRESET_SYSEX_TAG    0x50
+#define PRESET_SYSEX_MAX    50    // longest preset SysEx message (F0 and F7 excluded): set with all the fields
+
+struct preset {                   // 32 bytes, as stored in flash
+  uint32_t waveforms;             // waveform mix: all waveforms are averaged (see synth::Waveform)
+  uint16_t attack_ms;             // envelope
+  uint16_t decay_ms;
+  uint16_t sustain;               // sustain volume
+  uint16_t sustain_ms;
+  uint16_t release_ms;
+  uint16_t volume;                // gain of the instrument
+  uint16_t cutoff;                // cutoff frequency of the low-pass filter (Hz); 0 if no filter
+  uint16_t route;                 // PRESET_INTERNAL, or PRESET_EXTERNAL | midi role << 8 | midi channel (0 to 15),
+                                  // plus PRESET_DRUMS if notes select drums as on the synth (BASS, SNARE, HAT)
+  uint16_t send;                  // send level to the effect bus (chorus and reverb, see fx.hpp); 0 if dry
+  uint16_t vibrato_rate;          // vibrato lfo rate (0.1 Hz)
+  uint16_t vibrato_depth;         // pitch deviation at the top of the vibrato (cents, up to PRESET_VIBRATO_MAX); 0 if no vibrato
+  uint16_t tremolo_rate;          // tremolo lfo rate (0.1 Hz)
+  uint16_t tremolo_depth;         // volume taken off at the bottom of the tremolo (0xffff: all of it); 0 if no tremolo
+  uint16_t filter_env;            // cutoff raised by the envelope, up to cutoff + filter_env at its top (Hz); needs a cutoff
+};
+
+#define PRESET_VIBRATO_MAX  1200
+
+#define PRESET_INTERNAL     0x0000
+#define PRESET_EXTERNAL     0x8000
+#define PRESET_DRUMS        0x4000
+#define PRESET_ROLES        3     // midi roles a preset can be routed to: UI, control surface, keyboard (see midi_role)
+#define PRESET_ROLE(route)      (((route) >> 8) & 0x03)
+#define PRESET_CHANNEL(route)   ((route) & 0x0F)
+
+// load presets from flash, or the built-in ones
+void presets_init(void);
+
+// instrument of preset number; nullptr if there is no such preset
+const synth::Instrument *preset_instrument(int number);
+
+// route of preset number; PRESET_INTERNAL if there is no such preset
+uint16_t preset_route(int number);
+
+// set preset number; returns false if the preset is not valid, or cannot be played by this firmware
+bool preset_set(int number, const struct preset *preset);
+
+// handle a preset SysEx message (F0 and F7 excluded); returns the number of the preset changed,
+// NB_INSTRUMENTS if all presets changed, -1 if none
+int preset_sysex(const uint8_t *data, uint16_t length);
+
+// SysEx message giving preset number as it is now (F0 and F7 excluded), in data (PRESET_SYSEX_MAX bytes): a set
+// message, or a back to the built-in presets message if number is NB_INSTRUMENTS. Returns its length; 0 if the
+// preset is the built-in one, and there is nothing to set
+uint16_t preset_message(int number, uint8_t *data);
+
+// true if presets have to be stored in flash, as asked by a SysEx message
+bool presets_pending(void);
+
+// store presets in flash; the sector erase stops everything for tens of msec, so this must only
+// be called when no sound is played. Returns false if there was nothing to store
+bool presets_store(void);
@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+#include "recorder.hpp"
+#include "synth.hpp"
+
+static_assert(sizeof(struct rec_record) == 12, "recorder record must be 12 bytes");
+
+recorder_mode rec_mode = REC_OFF;
+
+static struct rec_record *rec_log = nullptr;
+static uint32_t rec_count = 0;            // number of records in the log
+static struct rec_start rec_from;         // state the log starts from
+static uint32_t rec_frames = 0;           // audio frames rendered during the recording
+static uint32_t rec_checksum = 0;         // checksum of the audio rendered during the recording
+
+static uint32_t start_us = 0;             // start of the recording, in usec since boot
+static uint32_t frames = 0;               // audio frames rendered since the start of recording / replay
+static uint32_t checksum = 0;             // checksum of the audio rendered since the start of recording / replay
+static uint32_t next_record = 0;          // replay: next record to be handled
+
+static uint32_t dump_next = 0;            // dump: next record to be printed
+static bool dumping = false;
+static bool loading = false;
+
+#define CHECKSUM_SEED   2166136261u       // FNV-1a
+#define CHECKSUM_PRIME  16777619u
+
+
+void rec_init(void) {
+  rec_log = (struct rec_record *) arena_take(ARENA_RECORDER, REC_ARENA_BYTES);
+}
+
+
+static void restart(void) {
+  start_us = time_us_32();
+  frames = 0;
+  checksum = CHECKSUM_SEED;
+  next_record = 0;
+}
+
+
+void rec_record(const struct rec_start *start) {
+  rec_stop();
+  rec_from = *start;
+  rec_count = 0;
+  restart();
+  rec_mode = REC_RECORDING;
+  printf("Recording from song %u step %u\r\n", rec_from.song_num, rec_from.step);
+}
+
+
+bool rec_replay(struct rec_start *start) {
+  rec_stop();
+  if(rec_frames == 0) return false;
+  *start = rec_from;
+  restart();
+  rec_mode = REC_REPLAYING;
+  printf("Replaying %lu events, %lu frames\r\n", (unsigned long) rec_count, (unsigned long) rec_frames);
+  return true;
+}
+
+
+void rec_stop(void) {
+  if(rec_mode == REC_RECORDING) {
+    rec_frames = frames;
+    rec_checksum = checksum;
+    printf("Recorded %lu events, %lu frames, audio checksum %08lx\r\n", (unsigned long) rec_count, (unsigned long) rec_frames,
+      (unsigned long) rec_checksum);
+  }
+  else if(rec_mode == REC_REPLAYING) {
+    printf("Replay stopped at frame %lu of %lu\r\n", (unsigned long) frames, (unsigned long) rec_frames);
+  }
+  rec_mode = REC_OFF;
+}
+
+
+void rec_event(uint8_t type, uint8_t data0, uint8_t data1, uint8_t data2) {
+  if(rec_mode != REC_RECORDING) return;
+  if(rec_count == REC_SIZE) {
+    // recording stops where the log ends, so that the log and its checksum go together
+    printf("Recorder log is full\r\n");
+    rec_stop();
+    return;
+  }
+
+  struct rec_record *record = &rec_log[rec_count++];
+  record->time = time_us_32() - start_us;
+  record->frame = frames;
+  record->type = type;
+  record->data[0] = data0;
+  record->data[1] = data1;
+  record->data[2] = data2;
+}
+
+
+void rec_sysex(const uint8_t *data, uint16_t length) {
+  if(rec_mode != REC_RECORDING) return;
+  for(uint32_t i = 0; i <= length; i += 3) {
+    rec_event(REC_SYSEX, (i < length) ? data[i] : 0xF7, (i + 1 < length) ? data[i + 1] : 0xF7, (i + 2 < length) ? data[i + 2] : 0xF7);
+  }
+}
+
+
+const struct rec_record *rec_next(void) {
+  if(rec_mode != REC_REPLAYING) return nullptr;
+  if((next_record == rec_count) || (rec_log[next_record].frame > frames)) return nullptr;
+  return &rec_log[next_record++];
+}
+
+
+void rec_audio(const int16_t *samples, uint32_t count) {
+  if(rec_mode == REC_OFF) return;
+
+  for(uint32_t i = 0; i < count * synth::output_channels; i++) {
+    checksum = (checksum ^ uint16_t(samples[i])) * CHECKSUM_PRIME;
+  }
+  frames += count;
+
+  // end of replay: audio must be the same as when it was recorded
+  if((rec_mode == REC_REPLAYING) && (frames >= rec_frames) && (next_record == rec_count)) {
+    printf("Replay done: audio checksum %08lx, %s\r\n", (unsigned long) checksum,
+      ((frames == rec_frames) && (checksum == rec_checksum)) ? "identical" : "DIFFERENT");
+    rec_mode = REC_OFF;
+  }
+}
+
+
+void rec_dump_start(void) {
+  dump_next = 0;
+  dumping = true;
+  printf("REC %lu %u %u %u %d %lu %08lx\r\n", (unsigned long) rec_count, rec_from.song_num, rec_from.step, rec_from.instr_offset,
+    rec_from.transpose, (unsigned long) rec_frames, (unsigned long) rec_checksum);
+}
+
+
+bool rec_dump_next(void) {
+  if(!dumping) return false;
+  if(dump_next == rec_count) {
+    printf("END\r\n");
+    dumping = false;
+    return false;
+  }
+  const struct rec_record *record = &rec_log[dump_next++];
+  printf("%08lx %08lx %02x %02x%02x%02x\r\n", (unsigned long) record->time, (unsigned long) record->frame, record->type,
+    record->data[0], record->data[1], record->data[2]);
+  return true;
+}
+
+
+void rec_load_start(void) {
+  rec_stop();
+  if(!RECORDER_ENABLED) {
+    printf("Show recorder not compiled in (RECORDER option)\r\n");
+    return;
+  }
+  rec_count = 0;
+  rec_frames = 0;
+  loading = true;
+}
+
+
+bool rec_loading(void) {
+  return loading;
+}
+
+
+void rec_load_line(const char *line) {
+  unsigned long time, frame, data, count, total, check;
+  unsigned int song, step, instr, type;
+  int transpose;
+
+  if(strcmp(line, "END") == 0) {
+    loading = false;
+    printf("Loaded %lu events, %lu frames\r\n", (unsigned long) rec_count, (unsigned long) rec_frames);
+  }
+  else if(strncmp(line, "REC", 3) == 0) {
+    if(sscanf(line, "REC %lu %u %u %u %d %lu %lx", &count, &song, &step, &instr, &transpose, &total, &check) != 7) return;
+    rec_from.song_num = song;
+    rec_from.step = step;
+    rec_from.instr_offset = instr;
+    rec_from.transpose = transpose;
+    rec_frames = total;
+    rec_checksum = check;
+  }
+  else if(rec_count < REC_SIZE) {
+    if(sscanf(line, "%lx %lx %x %lx", &time, &frame, &type, &data) != 4) return;
+    struct rec_record *record = &rec_log[rec_count++];
+    record->time = time;
+    record->frame = frame;
+    record->type = type;
+    record->data[0] = data >> 16;
+    record->data[1] = data >> 8;
+    record->data[2] = data;
+  }
+}
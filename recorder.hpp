@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include "arena.hpp"
+
+// show recorder: log of the inputs of a show, replayed to reproduce it
+//
+// Recording logs every input handled by the main loop (pedal changes, launchpad and keyboard events, preset
+// SysEx messages), plus song loads and instrument changes as markers, each with its time and the audio frame it was
+// handled at. Recording and replay start from the same state (song, position, instruments, silent voices; the
+// presets are logged first, as the SysEx messages which set them),
+// and replay feeds the logged inputs back through the same code, just before the audio frame they were
+// handled at: audio is then rendered bit for bit as it was, which the checksum of the rendered audio,
+// printed at the end of both, confirms. A glitch seen live can so be replayed and profiled at will.
+//
+// The log is kept in RAM, taken from the arena (see arena.hpp). It is dumped over stdio as hex lines between "REC" and "END", and the same
+// lines can be sent back (see rec_load_start) to replay a show on another device.
+// The recorder is compiled in with RECORDER_ENABLED (RECORDER CMake option); the log is only taken from the arena then.
+
+#ifndef RECORDER_ENABLED
+#define RECORDER_ENABLED 0
+#endif
+
+#define REC_SIZE          1024    // max number of records in the log
+
+enum rec_type : uint8_t {
+  REC_PEDAL = 1,                  // pedal change; data: value | previous value << 4, time since previous change (ms, 16 bits)
+  REC_MIDI,                       // midi event; data: type | role << 4, pad, value
+  REC_SONG,                       // song loaded (marker); data: song number (16 bits)
+  REC_INSTRUMENT,                 // instrument offset changed (marker); data: offset
+  REC_SYSEX,                      // part of a preset SysEx message; data: 3 bytes of the message, padded with F7 after its end
+};
+
+struct rec_record {               // 12 bytes
+  uint32_t time;                  // usec since the start of the recording
+  uint32_t frame;                 // audio frames rendered since the start of the recording when the event was handled
+  uint8_t type;                   // record type (see rec_type)
+  uint8_t data[3];
+};
+
+// RAM of the log in the arena
+#define REC_ARENA_BYTES   (RECORDER_ENABLED ? REC_SIZE * sizeof(struct rec_record) : 0)
+
+struct rec_start {                // state the recording starts from
+  uint16_t song_num;
+  uint16_t step;                  // next step number
+  uint16_t instr_offset;
+  int16_t transpose;
+};
+
+enum recorder_mode : uint8_t {
+  REC_OFF,
+  REC_RECORDING,
+  REC_REPLAYING
+};
+
+extern recorder_mode rec_mode;
+
+// take the log from the arena
+void rec_init(void);
+
+// start recording from the given state; the previous log is lost
+void rec_record(const struct rec_start *start);
+
+// start replaying the log; gives the state it starts from. Returns false if there is nothing to replay
+bool rec_replay(struct rec_start *start);
+
+// stop recording or replaying
+void rec_stop(void);
+
+// log an event, while recording
+void rec_event(uint8_t type, uint8_t data0, uint8_t data1, uint8_t data2);
+
+// log a SysEx message (F0 and F7 excluded), while recording: its bytes go in REC_SYSEX records, all at the same frame,
+// the last one ended by F7 (a record of F7 alone if the length is a multiple of 3)
+void rec_sysex(const uint8_t *data, uint16_t length);
+
+// replay: next event to be handled before the next audio frame is rendered; nullptr if none
+const struct rec_record *rec_next(void);
+
+// count the rendered audio frames, and add them to the audio checksum; replay ends once all its frames are rendered
+void rec_audio(const int16_t *samples, uint32_t count);
+
+// print the log over stdio, a record per call of rec_dump_next(), as trace_dump_start() does
+void rec_dump_start(void);
+bool rec_dump_next(void);         // returns false once the dump is over
+
+// load a log printed by the dump: lines are then given to rec_load_line() until the "END" line
+// (nothing is loaded if the recorder is not compiled in)
+void rec_load_start(void);
+bool rec_loading(void);
+void rec_load_line(const char *line);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include "hardware/sync.h"
+
+// lock-free single producer / single consumer ring buffer
+// the producer is typically an interrupt handler or a callback, the consumer the main loop.
+// Only the producer writes head, only the consumer writes tail, so no lock is needed;
+// the memory barriers make sure an item is complete before it is seen by the other side.
+// N must be a power of 2.
+template <typename T, uint32_t N>
+struct spsc_ring {
+  static_assert((N & (N - 1)) == 0, "ring size must be a power of 2");
+
+  T items[N];
+  volatile uint32_t head = 0;     // next slot to write (producer only)
+  volatile uint32_t tail = 0;     // next slot to read (consumer only)
+  volatile uint32_t dropped = 0;  // number of items lost because the ring was full
+
+  // add an item; returns false (and drops the item) if the ring is full
+  bool push(const T &item) {
+    uint32_t h = head;
+    if(h - tail == N) {
+      dropped = dropped + 1;
+      return false;
+    }
+    items[h & (N - 1)] = item;
+    __dmb();
+    head = h + 1;
+    return true;
+  }
+
+  // remove the oldest item; returns false if the ring is empty
+  bool pop(T &item) {
+    uint32_t t = tail;
+    if(t == head) return false;
+    __dmb();
+    item = items[t & (N - 1)];
+    __dmb();
+    tail = t + 1;
+    return true;
+  }
+
+  bool empty() const {
+    return head == tail;
+  }
+
+  uint32_t count() const {
+    return head - tail;
+  }
+};
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+
+#include "sched.hpp"
+
+static struct sched_task *sched_tasks = nullptr;
+static uint32_t sched_count = 0;
+
+// idle time accounting, for the reports
+static uint64_t idle_us = 0;
+static uint64_t report_start_us = 0;
+static uint32_t reported_overruns = 0;
+
+#define REPORT_PERIOD_US  30000000    // report at most every 30 sec, and only when some task went over budget
+
+
+// systick is used as a free running cycle counter (24 bits, counting down at cpu clock)
+static inline uint32_t cycles_now() {
+  return systick_hw->cvr;
+}
+
+static inline uint32_t cycles_since(uint32_t start) {
+  return (start - systick_hw->cvr) & 0xffffff;
+}
+
+
+void sched_init(struct sched_task *tasks, uint32_t count) {
+  uint32_t now = time_us_32();
+
+  sched_tasks = tasks;
+  sched_count = count;
+
+  for(uint32_t i = 0; i < count; i++) {
+    tasks[i].next_due = now;
+    tasks[i].runs = 0;
+    tasks[i].busy_runs = 0;
+    tasks[i].total_cycles = 0;
+    tasks[i].max_cycles = 0;
+    tasks[i].overruns = 0;
+  }
+
+  // systick: processor clock, no interrupt, full 24 bit range
+  systick_hw->rvr = 0xffffff;
+  systick_hw->cvr = 0;
+  systick_hw->csr = 0x5;
+
+  report_start_us = time_us_64();
+}
+
+
+// run the highest priority task that is due and has something to do
+// returns false when no task had anything to do
+bool sched_pass(void) {
+  for(uint32_t i = 0; i < sched_count; i++) {
+    struct sched_task *task = &sched_tasks[i];
+    uint32_t now = time_us_32();
+
+    // periodic task which is not due yet
+    if(task->period_us && (int32_t(now - task->next_due) < 0)) continue;
+
+    uint32_t start = cycles_now();
+    bool busy = task->run();
+    uint32_t cycles = cycles_since(start);
+
+    if(task->period_us) {
+      // next deadline; if we are late by more than a period, don't try to catch up
+      task->next_due += task->period_us;
+      if(int32_t(now - task->next_due) >= 0) task->next_due = now + task->period_us;
+    }
+
+    task->runs++;
+    task->total_cycles += cycles;
+    if(cycles > task->max_cycles) task->max_cycles = cycles;
+    if(cycles > task->budget_cycles) task->overruns++;
+
+    if(busy) {
+      task->busy_runs++;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// scheduler main loop; never returns
+void sched_run(void) {
+  while(true) {
+    if(sched_pass()) continue;
+
+    // nothing to do: sleep until next deadline, or until an interrupt (usb, audio dma, pedal...) occurs
+    uint32_t now = time_us_32();
+    uint32_t sleep_us = SCHED_MAX_SLEEP_US;
+    for(uint32_t i = 0; i < sched_count; i++) {
+      if(sched_tasks[i].period_us == 0) continue;
+      int32_t due_in = int32_t(sched_tasks[i].next_due - now);
+      if(due_in < 0) due_in = 0;
+      if(uint32_t(due_in) < sleep_us) sleep_us = due_in;
+    }
+    if(sleep_us) {
+      uint64_t start = time_us_64();
+      best_effort_wfe_or_timeout(make_timeout_time_us(sleep_us));
+      idle_us += time_us_64() - start;
+    }
+
+    // report over stdio if some task went over its budget
+    uint32_t overruns = 0;
+    for(uint32_t i = 0; i < sched_count; i++) overruns += sched_tasks[i].overruns;
+    if((overruns != reported_overruns) && (time_us_64() - report_start_us >= REPORT_PERIOD_US)) {
+      sched_report();
+      reported_overruns = overruns;
+    }
+  }
+}
+
+
+// print task measurements and idle ratio, then restart idle measurement
+void sched_report(void) {
+  uint64_t now = time_us_64();
+  uint64_t elapsed = now - report_start_us;
+
+  printf("task        runs     busy   avg cyc   max cyc    budget  overruns\r\n");
+  for(uint32_t i = 0; i < sched_count; i++) {
+    struct sched_task *task = &sched_tasks[i];
+    uint32_t average = task->runs ? uint32_t(task->total_cycles / task->runs) : 0;
+    printf("%-8s %7lu  %7lu  %8lu  %8lu  %8lu  %8lu\r\n", task->name, (unsigned long) task->runs, (unsigned long) task->busy_runs,
+      (unsigned long) average, (unsigned long) task->max_cycles, (unsigned long) task->budget_cycles, (unsigned long) task->overruns);
+  }
+  printf("idle: %lu%%\r\n", (unsigned long) (elapsed ? (idle_us * 100) / elapsed : 0));
+
+  idle_us = 0;
+  report_start_us = now;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// small cooperative scheduler for the main loop
+//
+// Tasks are given in priority order (first task = highest priority). A scheduling pass
+// goes through the tasks in that order and runs the ones that are due; as soon as a task
+// reports it did some work, the pass starts again from the highest priority task, so that
+// a lower priority task never delays a higher priority one by more than a single run.
+// When a complete pass finds nothing to do, the core sleeps (__wfe) until an interrupt
+// occurs or the next task deadline is reached.
+//
+// Each run of a task is measured in cpu cycles and compared to the task budget.
+
+struct sched_task {
+  const char *name;               // task name, for reports
+  bool (*run)(void);              // task body; returns true if it did some work
+  uint32_t period_us;             // task is due every period_us; 0 if the task is polled at every pass
+  uint32_t budget_cycles;         // number of cycles a run of the task is expected to take at most
+
+  // internal state and measurements
+  uint32_t next_due = 0;          // next deadline, in usec since boot (periodic tasks only)
+  uint32_t runs = 0;              // number of runs
+  uint32_t busy_runs = 0;         // number of runs where the task did some work
+  uint64_t total_cycles = 0;      // cycles spent in the task, for average
+  uint32_t max_cycles = 0;        // worst run
+  uint32_t overruns = 0;          // number of runs over budget
+};
+
+#define SCHED_US_TO_CYCLES(us)  ((us) * (SYS_CLK_KHZ / 1000))
+#define SCHED_MAX_SLEEP_US      1000      // sleep at most 1ms, so that polled tasks are polled regularly
+
+void sched_init(struct sched_task *tasks, uint32_t count);
+bool sched_pass(void);
+void sched_run(void);
+void sched_report(void);
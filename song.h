@@ -1,2 +1,2 @@
-const uint16_t song [6018] = {19,20,305,590,735,1020,1305,1590,1735,2020,2305,2590,2735,3020,3305,3590,3735,4020,5082,5436,3,56,0,0,0,65,78,98,0x00,0x3E,73,87,104,0x01,0x3E,78,98,117,0x02,0x3E,87,104,131,0x03,0x3E,98,117,147,0x04,0x3E,104,131,156,0x05,0x3E,117,147,175,0x06,0x3F,131,156,196,0x10,0x3F,147,175,208,0x11,0x3F,156,196,233,0x12,0x3F,175,208,262,0x13,0x3F,196,233,294,0x14,0x3F,208,262,311,0x15,0x3F,233,294,349,0x16,0x3F,262,311,392,0x20,0x0F,294,349,415,0x21,0x0F,311,392,466,0x22,0x0F,349,415,523,0x23,0x0F,392,466,587,0x24,0x0F,415,523,622,0x25,0x0F,466,587,698,0x26,0x0F,523,622,784,0x30,0x2F,587,698,831,0x31,0x2F,622,784,932,0x32,0x2F,698,831,1046,0x33,0x2F,784,932,1175,0x34,0x2F,831,1046,1244,0x35,0x2F,932,1175,1397,0x36,0x2F,69,82,104,0x40,0x3E,78,92,110,0x41,0x3E,82,104,123,0x42,0x3E,92,110,139,0x43,0x3E,104,123,156,0x44,0x3E,110,139,165,0x45,0x3E,123,156,185,0x46,0x3F,139,165,208,0x50,0x3F,156,185,220,0x51,0x3F,165,208,247,0x52,0x3F,185,220,277,0x53,0x3F,208,247,311,0x54,0x3F,220,277,330,0x55,0x3F,247,311,370,0x56,0x3F,277,330,415,0x60,0x0F,311,370,440,0x61,0x0F,330,415,494,0x62,0x0F,370,440,554,0x63,0x0F,415,494,622,0x64,0x0F,440,554,659,0x65,0x0F,494,622,740,0x66,0x0F,554,659,831,0x70,0x2F,622,740,880,0x71,0x2F,659,831,988,0x72,0x2F,740,880,1109,0x73,0x2F,831,988,1244,0x74,0x2F,880,1109,1318,0x75,0x2F,988,1244,1480,0x76,0x2F,3,56,0,0,0,73,87,110,0x00,0x3E,82,98,117,0x01,0x3E,87,110,131,0x02,0x3E,98,117,147,0x03,0x3E,110,131,165,0x04,0x3E,117,147,175,0x05,0x3E,131,165,196,0x06,0x3F,147,175,220,0x10,0x3F,165,196,233,0x11,0x3F,175,220,262,0x12,0x3F,196,233,294,0x13,0x3F,220,262,330,0x14,0x3F,233,294,349,0x15,0x3F,262,330,392,0x16,0x3F,294,349,440,0x20,0x0F,330,392,466,0x21,0x0F,349,440,523,0x22,0x0F,392,466,587,0x23,0x0F,440,523,659,0x24,0x0F,466,587,698,0x25,0x0F,523,659,784,0x26,0x0F,587,698,880,0x30,0x2F,659,784,932,0x31,0x2F,698,880,1046,0x32,0x2F,784,932,1175,0x33,0x2F,880,1046,1318,0x34,0x2F,932,1175,1397,0x35,0x2F,1046,1318,1568,0x36,0x2F,78,92,117,0x40,0x3E,87,104,123,0x41,0x3E,92,117,139,0x42,0x3E,104,123,156,0x43,0x3E,117,139,175,0x44,0x3E,123,156,185,0x45,0x3E,139,175,208,0x46,0x3F,156,185,233,0x50,0x3F,175,208,247,0x51,0x3F,185,233,277,0x52,0x3F,208,247,311,0x53,0x3F,233,277,349,0x54,0x3F,247,311,370,0x55,0x3F,277,349,415,0x56,0x3F,311,370,466,0x60,0x0F,349,415,494,0x61,0x0F,370,466,554,0x62,0x0F,415,494,622,0x63,0x0F,466,554,698,0x64,0x0F,494,622,740,0x65,0x0F,554,698,831,0x66,0x0F,622,740,932,0x70,0x2F,698,831,988,0x71,0x2F,740,932,1109,0x72,0x2F,831,988,1244,0x73,0x2F,932,1109,1397,0x74,0x2F,988,1244,1480,0x75,0x2F,1109,1397,1661,0x76,0x2F,3,28,0,0,0,82,98,123,0x00,0x3E,92,110,131,0x01,0x3E,98,123,147,0x02,0x3E,110,131,165,0x03,0x3E,123,147,185,0x04,0x3E,131,165,196,0x05,0x3E,147,185,220,0x06,0x3F,165,196,247,0x10,0x3F,185,220,262,0x11,0x3F,196,247,294,0x12,0x3F,220,262,330,0x13,0x3F,247,294,370,0x14,0x3F,262,330,392,0x15,0x3F,294,370,440,0x16,0x3F,330,392,494,0x20,0x0F,370,440,523,0x21,0x0F,392,494,587,0x22,0x0F,440,523,659,0x23,0x0F,494,587,740,0x24,0x0F,523,659,784,0x25,0x0F,587,740,880,0x26,0x0F,659,784,988,0x30,0x2F,740,880,1046,0x31,0x2F,784,988,1175,0x32,0x2F,880,1046,1318,0x33,0x2F,988,1175,1480,0x34,0x2F,1046,1318,1568,0x35,0x2F,1175,1480,1760,0x36,0x2F,3,56,0,0,0,87,104,131,0x00,0x3E,98,117,139,0x01,0x3E,104,131,156,0x02,0x3E,117,139,175,0x03,0x3E,131,156,196,0x04,0x3E,139,175,208,0x05,0x3E,156,196,233,0x06,0x3F,175,208,262,0x10,0x3F,196,233,277,0x11,0x3F,208,262,311,0x12,0x3F,233,277,349,0x13,0x3F,262,311,392,0x14,0x3F,277,349,415,0x15,0x3F,311,392,466,0x16,0x3F,349,415,523,0x20,0x0F,392,466,554,0x21,0x0F,415,523,622,0x22,0x0F,466,554,698,0x23,0x0F,523,622,784,0x24,0x0F,554,698,831,0x25,0x0F,622,784,932,0x26,0x0F,698,831,1046,0x30,0x2F,784,932,1109,0x31,0x2F,831,1046,1244,0x32,0x2F,932,1109,1397,0x33,0x2F,1046,1244,1568,0x34,0x2F,1109,1397,1661,0x35,0x2F,1244,1568,1865,0x36,0x2F,92,110,139,0x40,0x3E,104,123,147,0x41,0x3E,110,139,165,0x42,0x3E,123,147,185,0x43,0x3E,139,165,208,0x44,0x3E,147,185,220,0x45,0x3E,165,208,247,0x46,0x3F,185,220,277,0x50,0x3F,208,247,294,0x51,0x3F,220,277,330,0x52,0x3F,247,294,370,0x53,0x3F,277,330,415,0x54,0x3F,294,370,440,0x55,0x3F,330,415,494,0x56,0x3F,370,440,554,0x60,0x0F,415,494,587,0x61,0x0F,440,554,659,0x62,0x0F,494,587,740,0x63,0x0F,554,659,831,0x64,0x0F,587,740,880,0x65,0x0F,659,831,988,0x66,0x0F,740,880,1109,0x70,0x2F,831,988,1175,0x71,0x2F,880,1109,1318,0x72,0x2F,988,1175,1480,0x73,0x2F,1109,1318,1661,0x74,0x2F,1175,1480,1760,0x75,0x2F,1318,1661,1976,0x76,0x2F,3,56,0,0,0,98,117,147,0x00,0x3E,110,131,156,0x01,0x3E,117,147,175,0x02,0x3E,131,156,196,0x03,0x3E,147,175,220,0x04,0x3E,156,196,233,0x05,0x3E,175,220,262,0x06,0x3F,196,233,294,0x10,0x3F,220,262,311,0x11,0x3F,233,294,349,0x12,0x3F,262,311,392,0x13,0x3F,294,349,440,0x14,0x3F,311,392,466,0x15,0x3F,349,440,523,0x16,0x3F,392,466,587,0x20,0x0F,440,523,622,0x21,0x0F,466,587,698,0x22,0x0F,523,622,784,0x23,0x0F,587,698,880,0x24,0x0F,622,784,932,0x25,0x0F,698,880,1046,0x26,0x0F,784,932,1175,0x30,0x2F,880,1046,1244,0x31,0x2F,932,1175,1397,0x32,0x2F,1046,1244,1568,0x33,0x2F,1175,1397,1760,0x34,0x2F,1244,1568,1865,0x35,0x2F,1397,1760,2093,0x36,0x2F,104,123,156,0x40,0x3E,117,139,165,0x41,0x3E,123,156,185,0x42,0x3E,139,165,208,0x43,0x3E,156,185,233,0x44,0x3E,165,208,247,0x45,0x3E,185,233,277,0x46,0x3F,208,247,311,0x50,0x3F,233,277,330,0x51,0x3F,247,311,370,0x52,0x3F,277,330,415,0x53,0x3F,311,370,466,0x54,0x3F,330,415,494,0x55,0x3F,370,466,554,0x56,0x3F,415,494,622,0x60,0x0F,466,554,659,0x61,0x0F,494,622,740,0x62,0x0F,554,659,831,0x63,0x0F,622,740,932,0x64,0x0F,659,831,988,0x65,0x0F,740,932,1109,0x66,0x0F,831,988,1244,0x70,0x2F,932,1109,1318,0x71,0x2F,988,1244,1480,0x72,0x2F,1109,1318,1661,0x73,0x2F,1244,1480,1865,0x74,0x2F,1318,1661,1976,0x75,0x2F,1480,1865,2218,0x76,0x2F,3,56,0,0,0,110,131,165,0x00,0x3E,123,147,175,0x01,0x3E,131,165,196,0x02,0x3E,147,175,220,0x03,0x3E,165,196,247,0x04,0x3E,175,220,262,0x05,0x3E,196,247,294,0x06,0x3F,220,262,330,0x10,0x3F,247,294,349,0x11,0x3F,262,330,392,0x12,0x3F,294,349,440,0x13,0x3F,330,392,494,0x14,0x3F,349,440,523,0x15,0x3F,392,494,587,0x16,0x3F,440,523,659,0x20,0x0F,494,587,698,0x21,0x0F,523,659,784,0x22,0x0F,587,698,880,0x23,0x0F,659,784,988,0x24,0x0F,698,880,1046,0x25,0x0F,784,988,1175,0x26,0x0F,880,1046,1318,0x30,0x2F,988,1175,1397,0x31,0x2F,1046,1318,1568,0x32,0x2F,1175,1397,1760,0x33,0x2F,1318,1568,1976,0x34,0x2F,1397,1760,2093,0x35,0x2F,1568,1976,2349,0x36,0x2F,117,139,175,0x40,0x3E,131,156,185,0x41,0x3E,139,175,208,0x42,0x3E,156,185,233,0x43,0x3E,175,208,262,0x44,0x3E,185,233,277,0x45,0x3E,208,262,311,0x46,0x3F,233,277,349,0x50,0x3F,262,311,370,0x51,0x3F,277,349,415,0x52,0x3F,311,370,466,0x53,0x3F,349,415,523,0x54,0x3F,370,466,554,0x55,0x3F,415,523,622,0x56,0x3F,466,554,698,0x60,0x0F,523,622,740,0x61,0x0F,554,698,831,0x62,0x0F,622,740,932,0x63,0x0F,698,831,1046,0x64,0x0F,740,932,1109,0x65,0x0F,831,1046,1244,0x66,0x0F,932,1109,1397,0x70,0x2F,1046,1244,1480,0x71,0x2F,1109,1397,1661,0x72,0x2F,1244,1480,1865,0x73,0x2F,1397,1661,2093,0x74,0x2F,1480,1865,2218,0x75,0x2F,1661,2093,2489,0x76,0x2F,3,28,0,0,0,123,147,185,0x00,0x3E,139,165,196,0x01,0x3E,147,185,220,0x02,0x3E,165,196,247,0x03,0x3E,185,220,277,0x04,0x3E,196,247,294,0x05,0x3E,220,277,330,0x06,0x3F,247,294,370,0x10,0x3F,277,330,392,0x11,0x3F,294,370,440,0x12,0x3F,330,392,494,0x13,0x3F,370,440,554,0x14,0x3F,392,494,587,0x15,0x3F,440,554,659,0x16,0x3F,494,587,740,0x20,0x0F,554,659,784,0x21,0x0F,587,740,880,0x22,0x0F,659,784,988,0x23,0x0F,740,880,1109,0x24,0x0F,784,988,1175,0x25,0x0F,880,1109,1318,0x26,0x0F,988,1175,1480,0x30,0x2F,1109,1318,1568,0x31,0x2F,1175,1480,1760,0x32,0x2F,1318,1568,1976,0x33,0x2F,1480,1760,2218,0x34,0x2F,1568,1976,2349,0x35,0x2F,1760,2218,2637,0x36,0x2F,3,56,0,0,0,65,78,98,0x00,0x3E,73,87,104,0x01,0x3E,78,98,117,0x02,0x3E,87,104,131,0x03,0x3E,98,117,147,0x04,0x3E,104,131,156,0x05,0x3E,117,147,175,0x06,0x3F,131,156,196,0x10,0x3F,147,175,208,0x11,0x3F,156,196,233,0x12,0x3F,175,208,262,0x13,0x3F,196,233,294,0x14,0x3F,208,262,311,0x15,0x3F,233,294,349,0x16,0x3F,262,311,392,0x20,0x0F,294,349,415,0x21,0x0F,311,392,466,0x22,0x0F,349,415,523,0x23,0x0F,392,466,587,0x24,0x0F,415,523,622,0x25,0x0F,466,587,698,0x26,0x0F,523,622,784,0x30,0x2F,587,698,831,0x31,0x2F,622,784,932,0x32,0x2F,698,831,1046,0x33,0x2F,784,932,1175,0x34,0x2F,831,1046,1244,0x35,0x2F,932,1175,1397,0x36,0x2F,69,82,104,0x40,0x3E,78,92,110,0x41,0x3E,82,104,123,0x42,0x3E,92,110,139,0x43,0x3E,104,123,156,0x44,0x3E,110,139,165,0x45,0x3E,123,156,185,0x46,0x3F,139,165,208,0x50,0x3F,156,185,220,0x51,0x3F,165,208,247,0x52,0x3F,185,220,277,0x53,0x3F,208,247,311,0x54,0x3F,220,277,330,0x55,0x3F,247,311,370,0x56,0x3F,277,330,415,0x60,0x0F,311,370,440,0x61,0x0F,330,415,494,0x62,0x0F,370,440,554,0x63,0x0F,415,494,622,0x64,0x0F,440,554,659,0x65,0x0F,494,622,740,0x66,0x0F,554,659,831,0x70,0x2F,622,740,880,0x71,0x2F,659,831,988,0x72,0x2F,740,880,1109,0x73,0x2F,831,988,1244,0x74,0x2F,880,1109,1318,0x75,0x2F,988,1244,1480,0x76,0x2F,3,56,0,0,0,65,82,98,0x00,0x3E,73,87,110,0x01,0x3E,82,98,123,0x02,0x3E,87,110,131,0x03,0x3E,98,123,147,0x04,0x3E,110,131,165,0x05,0x3E,123,147,175,0x06,0x3F,131,165,196,0x10,0x3F,147,175,220,0x11,0x3F,165,196,247,0x12,0x3F,175,220,262,0x13,0x3F,196,247,294,0x14,0x3F,220,262,330,0x15,0x3F,247,294,349,0x16,0x3F,262,330,392,0x20,0x0F,294,349,440,0x21,0x0F,330,392,494,0x22,0x0F,349,440,523,0x23,0x0F,392,494,587,0x24,0x0F,440,523,659,0x25,0x0F,494,587,698,0x26,0x0F,523,659,784,0x30,0x2F,587,698,880,0x31,0x2F,659,784,988,0x32,0x2F,698,880,1046,0x33,0x2F,784,988,1175,0x34,0x2F,880,1046,1318,0x35,0x2F,988,1175,1397,0x36,0x2F,69,87,104,0x40,0x3E,78,92,117,0x41,0x3E,87,104,131,0x42,0x3E,92,117,139,0x43,0x3E,104,131,156,0x44,0x3E,117,139,175,0x45,0x3E,131,156,185,0x46,0x3F,139,175,208,0x50,0x3F,156,185,233,0x51,0x3F,175,208,262,0x52,0x3F,185,233,277,0x53,0x3F,208,262,311,0x54,0x3F,233,277,349,0x55,0x3F,262,311,370,0x56,0x3F,277,349,415,0x60,0x0F,311,370,466,0x61,0x0F,349,415,523,0x62,0x0F,370,466,554,0x63,0x0F,415,523,622,0x64,0x0F,466,554,698,0x65,0x0F,523,622,740,0x66,0x0F,554,698,831,0x70,0x2F,622,740,932,0x71,0x2F,698,831,1046,0x72,0x2F,740,932,1109,0x73,0x2F,831,1046,1244,0x74,0x2F,932,1109,1397,0x75,0x2F,1046,1244,1480,0x76,0x2F,3,56,0,0,0,73,92,110,0x00,0x3E,82,98,123,0x01,0x3E,92,110,139,0x02,0x3E,98,123,147,0x03,0x3E,110,139,165,0x04,0x3E,123,147,185,0x05,0x3E,139,165,196,0x06,0x3F,147,185,220,0x10,0x3F,165,196,247,0x11,0x3F,185,220,277,0x12,0x3F,196,247,294,0x13,0x3F,220,277,330,0x14,0x3F,247,294,370,0x15,0x3F,277,330,392,0x16,0x3F,294,370,440,0x20,0x0F,330,392,494,0x21,0x0F,370,440,554,0x22,0x0F,392,494,587,0x23,0x0F,440,554,659,0x24,0x0F,494,587,740,0x25,0x0F,554,659,784,0x26,0x0F,587,740,880,0x30,0x2F,659,784,988,0x31,0x2F,740,880,1109,0x32,0x2F,784,988,1175,0x33,0x2F,880,1109,1318,0x34,0x2F,988,1175,1480,0x35,0x2F,1109,1318,1568,0x36,0x2F,78,98,117,0x40,0x3E,87,104,131,0x41,0x3E,98,117,147,0x42,0x3E,104,131,156,0x43,0x3E,117,147,175,0x44,0x3E,131,156,196,0x45,0x3E,147,175,208,0x46,0x3F,156,196,233,0x50,0x3F,175,208,262,0x51,0x3F,196,233,294,0x52,0x3F,208,262,311,0x53,0x3F,233,294,349,0x54,0x3F,262,311,392,0x55,0x3F,294,349,415,0x56,0x3F,311,392,466,0x60,0x0F,349,415,523,0x61,0x0F,392,466,587,0x62,0x0F,415,523,622,0x63,0x0F,466,587,698,0x64,0x0F,523,622,784,0x65,0x0F,587,698,831,0x66,0x0F,622,784,932,0x70,0x2F,698,831,1046,0x71,0x2F,784,932,1175,0x72,0x2F,831,1046,1244,0x73,0x2F,932,1175,1397,0x74,0x2F,1046,1244,1568,0x75,0x2F,1175,1397,1661,0x76,0x2F,3,28,0,0,0,82,104,123,0x00,0x3E,92,110,139,0x01,0x3E,104,123,156,0x02,0x3E,110,139,165,0x03,0x3E,123,156,185,0x04,0x3E,139,165,208,0x05,0x3E,156,185,220,0x06,0x3F,165,208,247,0x10,0x3F,185,220,277,0x11,0x3F,208,247,311,0x12,0x3F,220,277,330,0x13,0x3F,247,311,370,0x14,0x3F,277,330,415,0x15,0x3F,311,370,440,0x16,0x3F,330,415,494,0x20,0x0F,370,440,554,0x21,0x0F,415,494,622,0x22,0x0F,440,554,659,0x23,0x0F,494,622,740,0x24,0x0F,554,659,831,0x25,0x0F,622,740,880,0x26,0x0F,659,831,988,0x30,0x2F,740,880,1109,0x31,0x2F,831,988,1244,0x32,0x2F,880,1109,1318,0x33,0x2F,988,1244,1480,0x34,0x2F,1109,1318,1661,0x35,0x2F,1244,1480,1760,0x36,0x2F,3,56,0,0,0,87,110,131,0x00,0x3E,98,117,147,0x01,0x3E,110,131,165,0x02,0x3E,117,147,175,0x03,0x3E,131,165,196,0x04,0x3E,147,175,220,0x05,0x3E,165,196,233,0x06,0x3F,175,220,262,0x10,0x3F,196,233,294,0x11,0x3F,220,262,330,0x12,0x3F,233,294,349,0x13,0x3F,262,330,392,0x14,0x3F,294,349,440,0x15,0x3F,330,392,466,0x16,0x3F,349,440,523,0x20,0x0F,392,466,587,0x21,0x0F,440,523,659,0x22,0x0F,466,587,698,0x23,0x0F,523,659,784,0x24,0x0F,587,698,880,0x25,0x0F,659,784,932,0x26,0x0F,698,880,1046,0x30,0x2F,784,932,1175,0x31,0x2F,880,1046,1318,0x32,0x2F,932,1175,1397,0x33,0x2F,1046,1318,1568,0x34,0x2F,1175,1397,1760,0x35,0x2F,1318,1568,1865,0x36,0x2F,92,117,139,0x40,0x3E,104,123,156,0x41,0x3E,117,139,175,0x42,0x3E,123,156,185,0x43,0x3E,139,175,208,0x44,0x3E,156,185,233,0x45,0x3E,175,208,247,0x46,0x3F,185,233,277,0x50,0x3F,208,247,311,0x51,0x3F,233,277,349,0x52,0x3F,247,311,370,0x53,0x3F,277,349,415,0x54,0x3F,311,370,466,0x55,0x3F,349,415,494,0x56,0x3F,370,466,554,0x60,0x0F,415,494,622,0x61,0x0F,466,554,698,0x62,0x0F,494,622,740,0x63,0x0F,554,698,831,0x64,0x0F,622,740,932,0x65,0x0F,698,831,988,0x66,0x0F,740,932,1109,0x70,0x2F,831,988,1244,0x71,0x2F,932,1109,1397,0x72,0x2F,988,1244,1480,0x73,0x2F,1109,1397,1661,0x74,0x2F,1244,1480,1865,0x75,0x2F,1397,1661,1976,0x76,0x2F,3,56,0,0,0,98,123,147,0x00,0x3E,110,131,165,0x01,0x3E,123,147,185,0x02,0x3E,131,165,196,0x03,0x3E,147,185,220,0x04,0x3E,165,196,247,0x05,0x3E,185,220,262,0x06,0x3F,196,247,294,0x10,0x3F,220,262,330,0x11,0x3F,247,294,370,0x12,0x3F,262,330,392,0x13,0x3F,294,370,440,0x14,0x3F,330,392,494,0x15,0x3F,370,440,523,0x16,0x3F,392,494,587,0x20,0x0F,440,523,659,0x21,0x0F,494,587,740,0x22,0x0F,523,659,784,0x23,0x0F,587,740,880,0x24,0x0F,659,784,988,0x25,0x0F,740,880,1046,0x26,0x0F,784,988,1175,0x30,0x2F,880,1046,1318,0x31,0x2F,988,1175,1480,0x32,0x2F,1046,1318,1568,0x33,0x2F,1175,1480,1760,0x34,0x2F,1318,1568,1976,0x35,0x2F,1480,1760,2093,0x36,0x2F,104,131,156,0x40,0x3E,117,139,175,0x41,0x3E,131,156,196,0x42,0x3E,139,175,208,0x43,0x3E,156,196,233,0x44,0x3E,175,208,262,0x45,0x3E,196,233,277,0x46,0x3F,208,262,311,0x50,0x3F,233,277,349,0x51,0x3F,262,311,392,0x52,0x3F,277,349,415,0x53,0x3F,311,392,466,0x54,0x3F,349,415,523,0x55,0x3F,392,466,554,0x56,0x3F,415,523,622,0x60,0x0F,466,554,698,0x61,0x0F,523,622,784,0x62,0x0F,554,698,831,0x63,0x0F,622,784,932,0x64,0x0F,698,831,1046,0x65,0x0F,784,932,1109,0x66,0x0F,831,1046,1244,0x70,0x2F,932,1109,1397,0x71,0x2F,1046,1244,1568,0x72,0x2F,1109,1397,1661,0x73,0x2F,1244,1568,1865,0x74,0x2F,1397,1661,2093,0x75,0x2F,1568,1865,2218,0x76,0x2F,3,56,0,0,0,110,139,165,0x00,0x3E,123,147,185,0x01,0x3E,139,165,208,0x02,0x3E,147,185,220,0x03,0x3E,165,208,247,0x04,0x3E,185,220,277,0x05,0x3E,208,247,294,0x06,0x3F,220,277,330,0x10,0x3F,247,294,370,0x11,0x3F,277,330,415,0x12,0x3F,294,370,440,0x13,0x3F,330,415,494,0x14,0x3F,370,440,554,0x15,0x3F,415,494,587,0x16,0x3F,440,554,659,0x20,0x0F,494,587,740,0x21,0x0F,554,659,831,0x22,0x0F,587,740,880,0x23,0x0F,659,831,988,0x24,0x0F,740,880,1109,0x25,0x0F,831,988,1175,0x26,0x0F,880,1109,1318,0x30,0x2F,988,1175,1480,0x31,0x2F,1109,1318,1661,0x32,0x2F,1175,1480,1760,0x33,0x2F,1318,1661,1976,0x34,0x2F,1480,1760,2218,0x35,0x2F,1661,1976,2349,0x36,0x2F,117,147,175,0x40,0x3E,131,156,196,0x41,0x3E,147,175,220,0x42,0x3E,156,196,233,0x43,0x3E,175,220,262,0x44,0x3E,196,233,294,0x45,0x3E,220,262,311,0x46,0x3F,233,294,349,0x50,0x3F,262,311,392,0x51,0x3F,294,349,440,0x52,0x3F,311,392,466,0x53,0x3F,349,440,523,0x54,0x3F,392,466,587,0x55,0x3F,440,523,622,0x56,0x3F,466,587,698,0x60,0x0F,523,622,784,0x61,0x0F,587,698,880,0x62,0x0F,622,784,932,0x63,0x0F,698,880,1046,0x64,0x0F,784,932,1175,0x65,0x0F,880,1046,1244,0x66,0x0F,932,1175,1397,0x70,0x2F,1046,1244,1568,0x71,0x2F,1175,1397,1760,0x72,0x2F,1244,1568,1865,0x73,0x2F,1397,1760,2093,0x74,0x2F,1568,1865,2349,0x75,0x2F,1760,2093,2489,0x76,0x2F,3,28,0,0,0,123,156,185,0x00,0x3E,139,165,208,0x01,0x3E,156,185,233,0x02,0x3E,165,208,247,0x03,0x3E,185,233,277,0x04,0x3E,208,247,311,0x05,0x3E,233,277,330,0x06,0x3F,247,311,370,0x10,0x3F,277,330,415,0x11,0x3F,311,370,466,0x12,0x3F,330,415,494,0x13,0x3F,370,466,554,0x14,0x3F,415,494,622,0x15,0x3F,466,554,659,0x16,0x3F,494,622,740,0x20,0x0F,554,659,831,0x21,0x0F,622,740,932,0x22,0x0F,659,831,988,0x23,0x0F,740,932,1109,0x24,0x0F,831,988,1244,0x25,0x0F,932,1109,1318,0x26,0x0F,988,1244,1480,0x30,0x2F,1109,1318,1661,0x31,0x2F,1244,1480,1865,0x32,0x2F,1318,1661,1976,0x33,0x2F,1480,1865,2218,0x34,0x2F,1661,1976,2489,0x35,0x2F,1865,2218,2637,0x36,0x2F,3,56,0,0,0,65,82,98,0x00,0x3E,73,87,110,0x01,0x3E,82,98,123,0x02,0x3E,87,110,131,0x03,0x3E,98,123,147,0x04,0x3E,110,131,165,0x05,0x3E,123,147,175,0x06,0x3F,131,165,196,0x10,0x3F,147,175,220,0x11,0x3F,165,196,247,0x12,0x3F,175,220,262,0x13,0x3F,196,247,294,0x14,0x3F,220,262,330,0x15,0x3F,247,294,349,0x16,0x3F,262,330,392,0x20,0x0F,294,349,440,0x21,0x0F,330,392,494,0x22,0x0F,349,440,523,0x23,0x0F,392,494,587,0x24,0x0F,440,523,659,0x25,0x0F,494,587,698,0x26,0x0F,523,659,784,0x30,0x2F,587,698,880,0x31,0x2F,659,784,988,0x32,0x2F,698,880,1046,0x33,0x2F,784,988,1175,0x34,0x2F,880,1046,1318,0x35,0x2F,988,1175,1397,0x36,0x2F,69,87,104,0x40,0x3E,78,92,117,0x41,0x3E,87,104,131,0x42,0x3E,92,117,139,0x43,0x3E,104,131,156,0x44,0x3E,117,139,175,0x45,0x3E,131,156,185,0x46,0x3F,139,175,208,0x50,0x3F,156,185,233,0x51,0x3F,175,208,262,0x52,0x3F,185,233,277,0x53,0x3F,208,262,311,0x54,0x3F,233,277,349,0x55,0x3F,262,311,370,0x56,0x3F,277,349,415,0x60,0x0F,311,370,466,0x61,0x0F,349,415,523,0x62,0x0F,370,466,554,0x63,0x0F,415,523,622,0x64,0x0F,466,554,698,0x65,0x0F,523,622,740,0x66,0x0F,554,698,831,0x70,0x2F,622,740,932,0x71,0x2F,698,831,1046,0x72,0x2F,740,932,1109,0x73,0x2F,831,1046,1244,0x74,0x2F,932,1109,1397,0x75,0x2F,1046,1244,1480,0x76,0x2F,4,176,1,1,1,1,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,294,349,440,523,0x50,0x3F,392,466,587,698,0x51,0x3E,294,349,440,523,0x52,0x3F,392,466,587,698,0x53,0x3E,294,349,440,523,0x54,0x3F,392,466,587,698,0x55,0x3E,466,294,349,0,0x56,0x0F,262,330,392,0,0x57,0x0F,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,294,349,440,523,0x50,0x3F,392,466,587,698,0x51,0x3E,294,349,440,523,0x52,0x3F,392,466,587,698,0x53,0x3E,294,349,440,523,0x54,0x3F,392,466,587,698,0x55,0x3E,466,294,349,0,0x56,0x0F,262,330,392,0,0x57,0x0F,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,294,349,440,523,0x50,0x3F,392,466,587,698,0x51,0x3E,294,349,440,523,0x52,0x3F,392,466,587,698,0x53,0x3E,294,349,440,523,0x54,0x3F,392,466,587,698,0x55,0x3E,466,294,349,0,0x56,0x0F,262,330,392,0,0x57,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,4,58,0,0,0,0,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,87,110,147,0,0x10,0x0F,87,117,147,0,0x11,0x3E,87,110,131,0,0x12,0x3F,110,139,165,0,0x13,0x2F,87,110,147,0,0x10,0x0F,87,117,147,0,0x11,0x3E,87,110,131,0,0x12,0x3F,110,139,165,0,0x13,0x2F,110,139,165,196,0x17,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x07,0x0F,4,96,0,0,0,0,147,175,220,0,0x00,0x0F,147,196,233,0,0x01,0x3E,139,165,220,196,0x02,0x3F,147,175,220,0,0x03,0x0F,147,175,220,0,0x04,0x0F,147,196,233,0,0x05,0x3E,139,165,220,196,0x06,0x3F,147,175,220,0,0x07,0x0F,147,196,233,0,0x20,0x0F,147,196,233,0,0x21,0x0F,165,208,247,147,0x22,0x3E,165,208,247,147,0x23,0x3E,175,220,262,0,0x24,0x2F,175,220,262,0,0x25,0x2F,165,208,247,147,0x26,0x3E,165,208,247,147,0x27,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x00,0x0F,147,196,233,0,0x01,0x3E,139,165,220,196,0x02,0x3F,147,175,220,0,0x03,0x0F,147,175,220,0,0x04,0x0F,147,196,233,0,0x05,0x3E,139,165,220,196,0x06,0x3F,147,175,220,0,0x07,0x0F,147,196,233,0,0x20,0x0F,147,196,233,0,0x21,0x0F,165,208,247,147,0x22,0x3E,165,208,247,147,0x23,0x3E,175,220,262,0,0x24,0x2F,175,220,262,0,0x25,0x2F,165,208,247,147,0x26,0x3E,165,208,247,147,0x27,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x64,0x0F,131,165,220,0,0x65,0x3E,165,208,247,147,0x66,0x3F,131,165,220,0,0x67,0x3E,147,175,220,0,0x64,0x0F,131,165,220,0,0x65,0x3E,165,208,247,147,0x66,0x3F,131,165,220,0,0x67,0x3E,147,175,220,0,0x00,0x0F,147,196,233,0,0x01,0x3E,139,165,220,196,0x02,0x3F,147,175,220,0,0x03,0x0F,147,175,220,0,0x04,0x0F,147,196,233,0,0x05,0x3E,139,165,220,196,0x06,0x3F,147,175,220,0,0x07,0x0F,147,196,233,0,0x20,0x0F,147,196,233,0,0x21,0x0F,165,208,247,147,0x22,0x3E,165,208,247,147,0x23,0x3E,175,220,262,0,0x24,0x2F,175,220,262,0,0x25,0x2F,165,208,247,147,0x26,0x3E,165,208,247,147,0x27,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E};
-
+constexpr uint16_t song [6018] = {19,20,305,590,735,1020,1305,1590,1735,2020,2305,2590,2735,3020,3305,3590,3735,4020,5082,5436,3,56,0,0,0,65,78,98,0x00,0x3E,73,87,104,0x01,0x3E,78,98,117,0x02,0x3E,87,104,131,0x03,0x3E,98,117,147,0x04,0x3E,104,131,156,0x05,0x3E,117,147,175,0x06,0x3F,131,156,196,0x10,0x3F,147,175,208,0x11,0x3F,156,196,233,0x12,0x3F,175,208,262,0x13,0x3F,196,233,294,0x14,0x3F,208,262,311,0x15,0x3F,233,294,349,0x16,0x3F,262,311,392,0x20,0x0F,294,349,415,0x21,0x0F,311,392,466,0x22,0x0F,349,415,523,0x23,0x0F,392,466,587,0x24,0x0F,415,523,622,0x25,0x0F,466,587,698,0x26,0x0F,523,622,784,0x30,0x2F,587,698,831,0x31,0x2F,622,784,932,0x32,0x2F,698,831,1046,0x33,0x2F,784,932,1175,0x34,0x2F,831,1046,1244,0x35,0x2F,932,1175,1397,0x36,0x2F,69,82,104,0x40,0x3E,78,92,110,0x41,0x3E,82,104,123,0x42,0x3E,92,110,139,0x43,0x3E,104,123,156,0x44,0x3E,110,139,165,0x45,0x3E,123,156,185,0x46,0x3F,139,165,208,0x50,0x3F,156,185,220,0x51,0x3F,165,208,247,0x52,0x3F,185,220,277,0x53,0x3F,208,247,311,0x54,0x3F,220,277,330,0x55,0x3F,247,311,370,0x56,0x3F,277,330,415,0x60,0x0F,311,370,440,0x61,0x0F,330,415,494,0x62,0x0F,370,440,554,0x63,0x0F,415,494,622,0x64,0x0F,440,554,659,0x65,0x0F,494,622,740,0x66,0x0F,554,659,831,0x70,0x2F,622,740,880,0x71,0x2F,659,831,988,0x72,0x2F,740,880,1109,0x73,0x2F,831,988,1244,0x74,0x2F,880,1109,1318,0x75,0x2F,988,1244,1480,0x76,0x2F,3,56,0,0,0,73,87,110,0x00,0x3E,82,98,117,0x01,0x3E,87,110,131,0x02,0x3E,98,117,147,0x03,0x3E,110,131,165,0x04,0x3E,117,147,175,0x05,0x3E,131,165,196,0x06,0x3F,147,175,220,0x10,0x3F,165,196,233,0x11,0x3F,175,220,262,0x12,0x3F,196,233,294,0x13,0x3F,220,262,330,0x14,0x3F,233,294,349,0x15,0x3F,262,330,392,0x16,0x3F,294,349,440,0x20,0x0F,330,392,466,0x21,0x0F,349,440,523,0x22,0x0F,392,466,587,0x23,0x0F,440,523,659,0x24,0x0F,466,587,698,0x25,0x0F,523,659,784,0x26,0x0F,587,698,880,0x30,0x2F,659,784,932,0x31,0x2F,698,880,1046,0x32,0x2F,784,932,1175,0x33,0x2F,880,1046,1318,0x34,0x2F,932,1175,1397,0x35,0x2F,1046,1318,1568,0x36,0x2F,78,92,117,0x40,0x3E,87,104,123,0x41,0x3E,92,117,139,0x42,0x3E,104,123,156,0x43,0x3E,117,139,175,0x44,0x3E,123,156,185,0x45,0x3E,139,175,208,0x46,0x3F,156,185,233,0x50,0x3F,175,208,247,0x51,0x3F,185,233,277,0x52,0x3F,208,247,311,0x53,0x3F,233,277,349,0x54,0x3F,247,311,370,0x55,0x3F,277,349,415,0x56,0x3F,311,370,466,0x60,0x0F,349,415,494,0x61,0x0F,370,466,554,0x62,0x0F,415,494,622,0x63,0x0F,466,554,698,0x64,0x0F,494,622,740,0x65,0x0F,554,698,831,0x66,0x0F,622,740,932,0x70,0x2F,698,831,988,0x71,0x2F,740,932,1109,0x72,0x2F,831,988,1244,0x73,0x2F,932,1109,1397,0x74,0x2F,988,1244,1480,0x75,0x2F,1109,1397,1661,0x76,0x2F,3,28,0,0,0,82,98,123,0x00,0x3E,92,110,131,0x01,0x3E,98,123,147,0x02,0x3E,110,131,165,0x03,0x3E,123,147,185,0x04,0x3E,131,165,196,0x05,0x3E,147,185,220,0x06,0x3F,165,196,247,0x10,0x3F,185,220,262,0x11,0x3F,196,247,294,0x12,0x3F,220,262,330,0x13,0x3F,247,294,370,0x14,0x3F,262,330,392,0x15,0x3F,294,370,440,0x16,0x3F,330,392,494,0x20,0x0F,370,440,523,0x21,0x0F,392,494,587,0x22,0x0F,440,523,659,0x23,0x0F,494,587,740,0x24,0x0F,523,659,784,0x25,0x0F,587,740,880,0x26,0x0F,659,784,988,0x30,0x2F,740,880,1046,0x31,0x2F,784,988,1175,0x32,0x2F,880,1046,1318,0x33,0x2F,988,1175,1480,0x34,0x2F,1046,1318,1568,0x35,0x2F,1175,1480,1760,0x36,0x2F,3,56,0,0,0,87,104,131,0x00,0x3E,98,117,139,0x01,0x3E,104,131,156,0x02,0x3E,117,139,175,0x03,0x3E,131,156,196,0x04,0x3E,139,175,208,0x05,0x3E,156,196,233,0x06,0x3F,175,208,262,0x10,0x3F,196,233,277,0x11,0x3F,208,262,311,0x12,0x3F,233,277,349,0x13,0x3F,262,311,392,0x14,0x3F,277,349,415,0x15,0x3F,311,392,466,0x16,0x3F,349,415,523,0x20,0x0F,392,466,554,0x21,0x0F,415,523,622,0x22,0x0F,466,554,698,0x23,0x0F,523,622,784,0x24,0x0F,554,698,831,0x25,0x0F,622,784,932,0x26,0x0F,698,831,1046,0x30,0x2F,784,932,1109,0x31,0x2F,831,1046,1244,0x32,0x2F,932,1109,1397,0x33,0x2F,1046,1244,1568,0x34,0x2F,1109,1397,1661,0x35,0x2F,1244,1568,1865,0x36,0x2F,92,110,139,0x40,0x3E,104,123,147,0x41,0x3E,110,139,165,0x42,0x3E,123,147,185,0x43,0x3E,139,165,208,0x44,0x3E,147,185,220,0x45,0x3E,165,208,247,0x46,0x3F,185,220,277,0x50,0x3F,208,247,294,0x51,0x3F,220,277,330,0x52,0x3F,247,294,370,0x53,0x3F,277,330,415,0x54,0x3F,294,370,440,0x55,0x3F,330,415,494,0x56,0x3F,370,440,554,0x60,0x0F,415,494,587,0x61,0x0F,440,554,659,0x62,0x0F,494,587,740,0x63,0x0F,554,659,831,0x64,0x0F,587,740,880,0x65,0x0F,659,831,988,0x66,0x0F,740,880,1109,0x70,0x2F,831,988,1175,0x71,0x2F,880,1109,1318,0x72,0x2F,988,1175,1480,0x73,0x2F,1109,1318,1661,0x74,0x2F,1175,1480,1760,0x75,0x2F,1318,1661,1976,0x76,0x2F,3,56,0,0,0,98,117,147,0x00,0x3E,110,131,156,0x01,0x3E,117,147,175,0x02,0x3E,131,156,196,0x03,0x3E,147,175,220,0x04,0x3E,156,196,233,0x05,0x3E,175,220,262,0x06,0x3F,196,233,294,0x10,0x3F,220,262,311,0x11,0x3F,233,294,349,0x12,0x3F,262,311,392,0x13,0x3F,294,349,440,0x14,0x3F,311,392,466,0x15,0x3F,349,440,523,0x16,0x3F,392,466,587,0x20,0x0F,440,523,622,0x21,0x0F,466,587,698,0x22,0x0F,523,622,784,0x23,0x0F,587,698,880,0x24,0x0F,622,784,932,0x25,0x0F,698,880,1046,0x26,0x0F,784,932,1175,0x30,0x2F,880,1046,1244,0x31,0x2F,932,1175,1397,0x32,0x2F,1046,1244,1568,0x33,0x2F,1175,1397,1760,0x34,0x2F,1244,1568,1865,0x35,0x2F,1397,1760,2093,0x36,0x2F,104,123,156,0x40,0x3E,117,139,165,0x41,0x3E,123,156,185,0x42,0x3E,139,165,208,0x43,0x3E,156,185,233,0x44,0x3E,165,208,247,0x45,0x3E,185,233,277,0x46,0x3F,208,247,311,0x50,0x3F,233,277,330,0x51,0x3F,247,311,370,0x52,0x3F,277,330,415,0x53,0x3F,311,370,466,0x54,0x3F,330,415,494,0x55,0x3F,370,466,554,0x56,0x3F,415,494,622,0x60,0x0F,466,554,659,0x61,0x0F,494,622,740,0x62,0x0F,554,659,831,0x63,0x0F,622,740,932,0x64,0x0F,659,831,988,0x65,0x0F,740,932,1109,0x66,0x0F,831,988,1244,0x70,0x2F,932,1109,1318,0x71,0x2F,988,1244,1480,0x72,0x2F,1109,1318,1661,0x73,0x2F,1244,1480,1865,0x74,0x2F,1318,1661,1976,0x75,0x2F,1480,1865,2218,0x76,0x2F,3,56,0,0,0,110,131,165,0x00,0x3E,123,147,175,0x01,0x3E,131,165,196,0x02,0x3E,147,175,220,0x03,0x3E,165,196,247,0x04,0x3E,175,220,262,0x05,0x3E,196,247,294,0x06,0x3F,220,262,330,0x10,0x3F,247,294,349,0x11,0x3F,262,330,392,0x12,0x3F,294,349,440,0x13,0x3F,330,392,494,0x14,0x3F,349,440,523,0x15,0x3F,392,494,587,0x16,0x3F,440,523,659,0x20,0x0F,494,587,698,0x21,0x0F,523,659,784,0x22,0x0F,587,698,880,0x23,0x0F,659,784,988,0x24,0x0F,698,880,1046,0x25,0x0F,784,988,1175,0x26,0x0F,880,1046,1318,0x30,0x2F,988,1175,1397,0x31,0x2F,1046,1318,1568,0x32,0x2F,1175,1397,1760,0x33,0x2F,1318,1568,1976,0x34,0x2F,1397,1760,2093,0x35,0x2F,1568,1976,2349,0x36,0x2F,117,139,175,0x40,0x3E,131,156,185,0x41,0x3E,139,175,208,0x42,0x3E,156,185,233,0x43,0x3E,175,208,262,0x44,0x3E,185,233,277,0x45,0x3E,208,262,311,0x46,0x3F,233,277,349,0x50,0x3F,262,311,370,0x51,0x3F,277,349,415,0x52,0x3F,311,370,466,0x53,0x3F,349,415,523,0x54,0x3F,370,466,554,0x55,0x3F,415,523,622,0x56,0x3F,466,554,698,0x60,0x0F,523,622,740,0x61,0x0F,554,698,831,0x62,0x0F,622,740,932,0x63,0x0F,698,831,1046,0x64,0x0F,740,932,1109,0x65,0x0F,831,1046,1244,0x66,0x0F,932,1109,1397,0x70,0x2F,1046,1244,1480,0x71,0x2F,1109,1397,1661,0x72,0x2F,1244,1480,1865,0x73,0x2F,1397,1661,2093,0x74,0x2F,1480,1865,2218,0x75,0x2F,1661,2093,2489,0x76,0x2F,3,28,0,0,0,123,147,185,0x00,0x3E,139,165,196,0x01,0x3E,147,185,220,0x02,0x3E,165,196,247,0x03,0x3E,185,220,277,0x04,0x3E,196,247,294,0x05,0x3E,220,277,330,0x06,0x3F,247,294,370,0x10,0x3F,277,330,392,0x11,0x3F,294,370,440,0x12,0x3F,330,392,494,0x13,0x3F,370,440,554,0x14,0x3F,392,494,587,0x15,0x3F,440,554,659,0x16,0x3F,494,587,740,0x20,0x0F,554,659,784,0x21,0x0F,587,740,880,0x22,0x0F,659,784,988,0x23,0x0F,740,880,1109,0x24,0x0F,784,988,1175,0x25,0x0F,880,1109,1318,0x26,0x0F,988,1175,1480,0x30,0x2F,1109,1318,1568,0x31,0x2F,1175,1480,1760,0x32,0x2F,1318,1568,1976,0x33,0x2F,1480,1760,2218,0x34,0x2F,1568,1976,2349,0x35,0x2F,1760,2218,2637,0x36,0x2F,3,56,0,0,0,65,78,98,0x00,0x3E,73,87,104,0x01,0x3E,78,98,117,0x02,0x3E,87,104,131,0x03,0x3E,98,117,147,0x04,0x3E,104,131,156,0x05,0x3E,117,147,175,0x06,0x3F,131,156,196,0x10,0x3F,147,175,208,0x11,0x3F,156,196,233,0x12,0x3F,175,208,262,0x13,0x3F,196,233,294,0x14,0x3F,208,262,311,0x15,0x3F,233,294,349,0x16,0x3F,262,311,392,0x20,0x0F,294,349,415,0x21,0x0F,311,392,466,0x22,0x0F,349,415,523,0x23,0x0F,392,466,587,0x24,0x0F,415,523,622,0x25,0x0F,466,587,698,0x26,0x0F,523,622,784,0x30,0x2F,587,698,831,0x31,0x2F,622,784,932,0x32,0x2F,698,831,1046,0x33,0x2F,784,932,1175,0x34,0x2F,831,1046,1244,0x35,0x2F,932,1175,1397,0x36,0x2F,69,82,104,0x40,0x3E,78,92,110,0x41,0x3E,82,104,123,0x42,0x3E,92,110,139,0x43,0x3E,104,123,156,0x44,0x3E,110,139,165,0x45,0x3E,123,156,185,0x46,0x3F,139,165,208,0x50,0x3F,156,185,220,0x51,0x3F,165,208,247,0x52,0x3F,185,220,277,0x53,0x3F,208,247,311,0x54,0x3F,220,277,330,0x55,0x3F,247,311,370,0x56,0x3F,277,330,415,0x60,0x0F,311,370,440,0x61,0x0F,330,415,494,0x62,0x0F,370,440,554,0x63,0x0F,415,494,622,0x64,0x0F,440,554,659,0x65,0x0F,494,622,740,0x66,0x0F,554,659,831,0x70,0x2F,622,740,880,0x71,0x2F,659,831,988,0x72,0x2F,740,880,1109,0x73,0x2F,831,988,1244,0x74,0x2F,880,1109,1318,0x75,0x2F,988,1244,1480,0x76,0x2F,3,56,0,0,0,65,82,98,0x00,0x3E,73,87,110,0x01,0x3E,82,98,123,0x02,0x3E,87,110,131,0x03,0x3E,98,123,147,0x04,0x3E,110,131,165,0x05,0x3E,123,147,175,0x06,0x3F,131,165,196,0x10,0x3F,147,175,220,0x11,0x3F,165,196,247,0x12,0x3F,175,220,262,0x13,0x3F,196,247,294,0x14,0x3F,220,262,330,0x15,0x3F,247,294,349,0x16,0x3F,262,330,392,0x20,0x0F,294,349,440,0x21,0x0F,330,392,494,0x22,0x0F,349,440,523,0x23,0x0F,392,494,587,0x24,0x0F,440,523,659,0x25,0x0F,494,587,698,0x26,0x0F,523,659,784,0x30,0x2F,587,698,880,0x31,0x2F,659,784,988,0x32,0x2F,698,880,1046,0x33,0x2F,784,988,1175,0x34,0x2F,880,1046,1318,0x35,0x2F,988,1175,1397,0x36,0x2F,69,87,104,0x40,0x3E,78,92,117,0x41,0x3E,87,104,131,0x42,0x3E,92,117,139,0x43,0x3E,104,131,156,0x44,0x3E,117,139,175,0x45,0x3E,131,156,185,0x46,0x3F,139,175,208,0x50,0x3F,156,185,233,0x51,0x3F,175,208,262,0x52,0x3F,185,233,277,0x53,0x3F,208,262,311,0x54,0x3F,233,277,349,0x55,0x3F,262,311,370,0x56,0x3F,277,349,415,0x60,0x0F,311,370,466,0x61,0x0F,349,415,523,0x62,0x0F,370,466,554,0x63,0x0F,415,523,622,0x64,0x0F,466,554,698,0x65,0x0F,523,622,740,0x66,0x0F,554,698,831,0x70,0x2F,622,740,932,0x71,0x2F,698,831,1046,0x72,0x2F,740,932,1109,0x73,0x2F,831,1046,1244,0x74,0x2F,932,1109,1397,0x75,0x2F,1046,1244,1480,0x76,0x2F,3,56,0,0,0,73,92,110,0x00,0x3E,82,98,123,0x01,0x3E,92,110,139,0x02,0x3E,98,123,147,0x03,0x3E,110,139,165,0x04,0x3E,123,147,185,0x05,0x3E,139,165,196,0x06,0x3F,147,185,220,0x10,0x3F,165,196,247,0x11,0x3F,185,220,277,0x12,0x3F,196,247,294,0x13,0x3F,220,277,330,0x14,0x3F,247,294,370,0x15,0x3F,277,330,392,0x16,0x3F,294,370,440,0x20,0x0F,330,392,494,0x21,0x0F,370,440,554,0x22,0x0F,392,494,587,0x23,0x0F,440,554,659,0x24,0x0F,494,587,740,0x25,0x0F,554,659,784,0x26,0x0F,587,740,880,0x30,0x2F,659,784,988,0x31,0x2F,740,880,1109,0x32,0x2F,784,988,1175,0x33,0x2F,880,1109,1318,0x34,0x2F,988,1175,1480,0x35,0x2F,1109,1318,1568,0x36,0x2F,78,98,117,0x40,0x3E,87,104,131,0x41,0x3E,98,117,147,0x42,0x3E,104,131,156,0x43,0x3E,117,147,175,0x44,0x3E,131,156,196,0x45,0x3E,147,175,208,0x46,0x3F,156,196,233,0x50,0x3F,175,208,262,0x51,0x3F,196,233,294,0x52,0x3F,208,262,311,0x53,0x3F,233,294,349,0x54,0x3F,262,311,392,0x55,0x3F,294,349,415,0x56,0x3F,311,392,466,0x60,0x0F,349,415,523,0x61,0x0F,392,466,587,0x62,0x0F,415,523,622,0x63,0x0F,466,587,698,0x64,0x0F,523,622,784,0x65,0x0F,587,698,831,0x66,0x0F,622,784,932,0x70,0x2F,698,831,1046,0x71,0x2F,784,932,1175,0x72,0x2F,831,1046,1244,0x73,0x2F,932,1175,1397,0x74,0x2F,1046,1244,1568,0x75,0x2F,1175,1397,1661,0x76,0x2F,3,28,0,0,0,82,104,123,0x00,0x3E,92,110,139,0x01,0x3E,104,123,156,0x02,0x3E,110,139,165,0x03,0x3E,123,156,185,0x04,0x3E,139,165,208,0x05,0x3E,156,185,220,0x06,0x3F,165,208,247,0x10,0x3F,185,220,277,0x11,0x3F,208,247,311,0x12,0x3F,220,277,330,0x13,0x3F,247,311,370,0x14,0x3F,277,330,415,0x15,0x3F,311,370,440,0x16,0x3F,330,415,494,0x20,0x0F,370,440,554,0x21,0x0F,415,494,622,0x22,0x0F,440,554,659,0x23,0x0F,494,622,740,0x24,0x0F,554,659,831,0x25,0x0F,622,740,880,0x26,0x0F,659,831,988,0x30,0x2F,740,880,1109,0x31,0x2F,831,988,1244,0x32,0x2F,880,1109,1318,0x33,0x2F,988,1244,1480,0x34,0x2F,1109,1318,1661,0x35,0x2F,1244,1480,1760,0x36,0x2F,3,56,0,0,0,87,110,131,0x00,0x3E,98,117,147,0x01,0x3E,110,131,165,0x02,0x3E,117,147,175,0x03,0x3E,131,165,196,0x04,0x3E,147,175,220,0x05,0x3E,165,196,233,0x06,0x3F,175,220,262,0x10,0x3F,196,233,294,0x11,0x3F,220,262,330,0x12,0x3F,233,294,349,0x13,0x3F,262,330,392,0x14,0x3F,294,349,440,0x15,0x3F,330,392,466,0x16,0x3F,349,440,523,0x20,0x0F,392,466,587,0x21,0x0F,440,523,659,0x22,0x0F,466,587,698,0x23,0x0F,523,659,784,0x24,0x0F,587,698,880,0x25,0x0F,659,784,932,0x26,0x0F,698,880,1046,0x30,0x2F,784,932,1175,0x31,0x2F,880,1046,1318,0x32,0x2F,932,1175,1397,0x33,0x2F,1046,1318,1568,0x34,0x2F,1175,1397,1760,0x35,0x2F,1318,1568,1865,0x36,0x2F,92,117,139,0x40,0x3E,104,123,156,0x41,0x3E,117,139,175,0x42,0x3E,123,156,185,0x43,0x3E,139,175,208,0x44,0x3E,156,185,233,0x45,0x3E,175,208,247,0x46,0x3F,185,233,277,0x50,0x3F,208,247,311,0x51,0x3F,233,277,349,0x52,0x3F,247,311,370,0x53,0x3F,277,349,415,0x54,0x3F,311,370,466,0x55,0x3F,349,415,494,0x56,0x3F,370,466,554,0x60,0x0F,415,494,622,0x61,0x0F,466,554,698,0x62,0x0F,494,622,740,0x63,0x0F,554,698,831,0x64,0x0F,622,740,932,0x65,0x0F,698,831,988,0x66,0x0F,740,932,1109,0x70,0x2F,831,988,1244,0x71,0x2F,932,1109,1397,0x72,0x2F,988,1244,1480,0x73,0x2F,1109,1397,1661,0x74,0x2F,1244,1480,1865,0x75,0x2F,1397,1661,1976,0x76,0x2F,3,56,0,0,0,98,123,147,0x00,0x3E,110,131,165,0x01,0x3E,123,147,185,0x02,0x3E,131,165,196,0x03,0x3E,147,185,220,0x04,0x3E,165,196,247,0x05,0x3E,185,220,262,0x06,0x3F,196,247,294,0x10,0x3F,220,262,330,0x11,0x3F,247,294,370,0x12,0x3F,262,330,392,0x13,0x3F,294,370,440,0x14,0x3F,330,392,494,0x15,0x3F,370,440,523,0x16,0x3F,392,494,587,0x20,0x0F,440,523,659,0x21,0x0F,494,587,740,0x22,0x0F,523,659,784,0x23,0x0F,587,740,880,0x24,0x0F,659,784,988,0x25,0x0F,740,880,1046,0x26,0x0F,784,988,1175,0x30,0x2F,880,1046,1318,0x31,0x2F,988,1175,1480,0x32,0x2F,1046,1318,1568,0x33,0x2F,1175,1480,1760,0x34,0x2F,1318,1568,1976,0x35,0x2F,1480,1760,2093,0x36,0x2F,104,131,156,0x40,0x3E,117,139,175,0x41,0x3E,131,156,196,0x42,0x3E,139,175,208,0x43,0x3E,156,196,233,0x44,0x3E,175,208,262,0x45,0x3E,196,233,277,0x46,0x3F,208,262,311,0x50,0x3F,233,277,349,0x51,0x3F,262,311,392,0x52,0x3F,277,349,415,0x53,0x3F,311,392,466,0x54,0x3F,349,415,523,0x55,0x3F,392,466,554,0x56,0x3F,415,523,622,0x60,0x0F,466,554,698,0x61,0x0F,523,622,784,0x62,0x0F,554,698,831,0x63,0x0F,622,784,932,0x64,0x0F,698,831,1046,0x65,0x0F,784,932,1109,0x66,0x0F,831,1046,1244,0x70,0x2F,932,1109,1397,0x71,0x2F,1046,1244,1568,0x72,0x2F,1109,1397,1661,0x73,0x2F,1244,1568,1865,0x74,0x2F,1397,1661,2093,0x75,0x2F,1568,1865,2218,0x76,0x2F,3,56,0,0,0,110,139,165,0x00,0x3E,123,147,185,0x01,0x3E,139,165,208,0x02,0x3E,147,185,220,0x03,0x3E,165,208,247,0x04,0x3E,185,220,277,0x05,0x3E,208,247,294,0x06,0x3F,220,277,330,0x10,0x3F,247,294,370,0x11,0x3F,277,330,415,0x12,0x3F,294,370,440,0x13,0x3F,330,415,494,0x14,0x3F,370,440,554,0x15,0x3F,415,494,587,0x16,0x3F,440,554,659,0x20,0x0F,494,587,740,0x21,0x0F,554,659,831,0x22,0x0F,587,740,880,0x23,0x0F,659,831,988,0x24,0x0F,740,880,1109,0x25,0x0F,831,988,1175,0x26,0x0F,880,1109,1318,0x30,0x2F,988,1175,1480,0x31,0x2F,1109,1318,1661,0x32,0x2F,1175,1480,1760,0x33,0x2F,1318,1661,1976,0x34,0x2F,1480,1760,2218,0x35,0x2F,1661,1976,2349,0x36,0x2F,117,147,175,0x40,0x3E,131,156,196,0x41,0x3E,147,175,220,0x42,0x3E,156,196,233,0x43,0x3E,175,220,262,0x44,0x3E,196,233,294,0x45,0x3E,220,262,311,0x46,0x3F,233,294,349,0x50,0x3F,262,311,392,0x51,0x3F,294,349,440,0x52,0x3F,311,392,466,0x53,0x3F,349,440,523,0x54,0x3F,392,466,587,0x55,0x3F,440,523,622,0x56,0x3F,466,587,698,0x60,0x0F,523,622,784,0x61,0x0F,587,698,880,0x62,0x0F,622,784,932,0x63,0x0F,698,880,1046,0x64,0x0F,784,932,1175,0x65,0x0F,880,1046,1244,0x66,0x0F,932,1175,1397,0x70,0x2F,1046,1244,1568,0x71,0x2F,1175,1397,1760,0x72,0x2F,1244,1568,1865,0x73,0x2F,1397,1760,2093,0x74,0x2F,1568,1865,2349,0x75,0x2F,1760,2093,2489,0x76,0x2F,3,28,0,0,0,123,156,185,0x00,0x3E,139,165,208,0x01,0x3E,156,185,233,0x02,0x3E,165,208,247,0x03,0x3E,185,233,277,0x04,0x3E,208,247,311,0x05,0x3E,233,277,330,0x06,0x3F,247,311,370,0x10,0x3F,277,330,415,0x11,0x3F,311,370,466,0x12,0x3F,330,415,494,0x13,0x3F,370,466,554,0x14,0x3F,415,494,622,0x15,0x3F,466,554,659,0x16,0x3F,494,622,740,0x20,0x0F,554,659,831,0x21,0x0F,622,740,932,0x22,0x0F,659,831,988,0x23,0x0F,740,932,1109,0x24,0x0F,831,988,1244,0x25,0x0F,932,1109,1318,0x26,0x0F,988,1244,1480,0x30,0x2F,1109,1318,1661,0x31,0x2F,1244,1480,1865,0x32,0x2F,1318,1661,1976,0x33,0x2F,1480,1865,2218,0x34,0x2F,1661,1976,2489,0x35,0x2F,1865,2218,2637,0x36,0x2F,3,56,0,0,0,65,82,98,0x00,0x3E,73,87,110,0x01,0x3E,82,98,123,0x02,0x3E,87,110,131,0x03,0x3E,98,123,147,0x04,0x3E,110,131,165,0x05,0x3E,123,147,175,0x06,0x3F,131,165,196,0x10,0x3F,147,175,220,0x11,0x3F,165,196,247,0x12,0x3F,175,220,262,0x13,0x3F,196,247,294,0x14,0x3F,220,262,330,0x15,0x3F,247,294,349,0x16,0x3F,262,330,392,0x20,0x0F,294,349,440,0x21,0x0F,330,392,494,0x22,0x0F,349,440,523,0x23,0x0F,392,494,587,0x24,0x0F,440,523,659,0x25,0x0F,494,587,698,0x26,0x0F,523,659,784,0x30,0x2F,587,698,880,0x31,0x2F,659,784,988,0x32,0x2F,698,880,1046,0x33,0x2F,784,988,1175,0x34,0x2F,880,1046,1318,0x35,0x2F,988,1175,1397,0x36,0x2F,69,87,104,0x40,0x3E,78,92,117,0x41,0x3E,87,104,131,0x42,0x3E,92,117,139,0x43,0x3E,104,131,156,0x44,0x3E,117,139,175,0x45,0x3E,131,156,185,0x46,0x3F,139,175,208,0x50,0x3F,156,185,233,0x51,0x3F,175,208,262,0x52,0x3F,185,233,277,0x53,0x3F,208,262,311,0x54,0x3F,233,277,349,0x55,0x3F,262,311,370,0x56,0x3F,277,349,415,0x60,0x0F,311,370,466,0x61,0x0F,349,415,523,0x62,0x0F,370,466,554,0x63,0x0F,415,523,622,0x64,0x0F,466,554,698,0x65,0x0F,523,622,740,0x66,0x0F,554,698,831,0x70,0x2F,622,740,932,0x71,0x2F,698,831,1046,0x72,0x2F,740,932,1109,0x73,0x2F,831,1046,1244,0x74,0x2F,932,1109,1397,0x75,0x2F,1046,1244,1480,0x76,0x2F,4,176,1,1,1,1,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,294,349,440,523,0x50,0x3F,392,466,587,698,0x51,0x3E,294,349,440,523,0x52,0x3F,392,466,587,698,0x53,0x3E,294,349,440,523,0x54,0x3F,392,466,587,698,0x55,0x3E,466,294,349,0,0x56,0x0F,262,330,392,0,0x57,0x0F,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,294,349,440,523,0x50,0x3F,392,466,587,698,0x51,0x3E,294,349,440,523,0x52,0x3F,392,466,587,698,0x53,0x3E,294,349,440,523,0x54,0x3F,392,466,587,698,0x55,0x3E,466,294,349,0,0x56,0x0F,262,330,392,0,0x57,0x0F,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,294,349,440,523,0x00,0x3F,330,392,494,0,0x01,0x3E,349,440,523,659,0x02,0x3F,330,392,494,0,0x03,0x3E,294,349,440,523,0x04,0x3F,330,392,494,0,0x05,0x3E,349,440,523,659,0x06,0x3F,330,392,494,0,0x07,0x3E,392,466,587,698,0x20,0x0F,392,466,587,698,0x21,0x0F,392,466,587,698,0x22,0x0F,392,466,587,698,0x23,0x0F,294,349,440,523,0x24,0x3F,330,392,494,0,0x25,0x3E,349,440,523,659,0x26,0x3F,330,392,494,0,0x27,0x3E,294,349,440,523,0x50,0x3F,392,466,587,698,0x51,0x3E,294,349,440,523,0x52,0x3F,392,466,587,698,0x53,0x3E,294,349,440,523,0x54,0x3F,392,466,587,698,0x55,0x3E,466,294,349,0,0x56,0x0F,262,330,392,0,0x57,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,466,294,349,0,0x30,0x3F,262,330,392,0,0x31,0x3E,294,349,440,523,0x32,0x0F,294,349,440,523,0x33,0x0F,466,294,349,0,0x34,0x3F,262,330,392,0,0x35,0x3E,294,349,440,0,0x36,0x0F,294,349,440,0,0x37,0x0F,4,58,0,0,0,0,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,87,110,147,0,0x10,0x0F,87,117,147,0,0x11,0x3E,87,110,131,0,0x12,0x3F,110,139,165,0,0x13,0x2F,87,110,147,0,0x10,0x0F,87,117,147,0,0x11,0x3E,87,110,131,0,0x12,0x3F,110,139,165,0,0x13,0x2F,110,139,165,196,0x17,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x00,0x0F,294,392,466,0,0x01,0x3E,294,349,466,0,0x02,0x3F,277,330,440,0,0x03,0x2F,294,349,440,0,0x07,0x0F,4,96,0,0,0,0,147,175,220,0,0x00,0x0F,147,196,233,0,0x01,0x3E,139,165,220,196,0x02,0x3F,147,175,220,0,0x03,0x0F,147,175,220,0,0x04,0x0F,147,196,233,0,0x05,0x3E,139,165,220,196,0x06,0x3F,147,175,220,0,0x07,0x0F,147,196,233,0,0x20,0x0F,147,196,233,0,0x21,0x0F,165,208,247,147,0x22,0x3E,165,208,247,147,0x23,0x3E,175,220,262,0,0x24,0x2F,175,220,262,0,0x25,0x2F,165,208,247,147,0x26,0x3E,165,208,247,147,0x27,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x00,0x0F,147,196,233,0,0x01,0x3E,139,165,220,196,0x02,0x3F,147,175,220,0,0x03,0x0F,147,175,220,0,0x04,0x0F,147,196,233,0,0x05,0x3E,139,165,220,196,0x06,0x3F,147,175,220,0,0x07,0x0F,147,196,233,0,0x20,0x0F,147,196,233,0,0x21,0x0F,165,208,247,147,0x22,0x3E,165,208,247,147,0x23,0x3E,175,220,262,0,0x24,0x2F,175,220,262,0,0x25,0x2F,165,208,247,147,0x26,0x3E,165,208,247,147,0x27,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x64,0x0F,131,165,220,0,0x65,0x3E,165,208,247,147,0x66,0x3F,131,165,220,0,0x67,0x3E,147,175,220,0,0x64,0x0F,131,165,220,0,0x65,0x3E,165,208,247,147,0x66,0x3F,131,165,220,0,0x67,0x3E,147,175,220,0,0x00,0x0F,147,196,233,0,0x01,0x3E,139,165,220,196,0x02,0x3F,147,175,220,0,0x03,0x0F,147,175,220,0,0x04,0x0F,147,196,233,0,0x05,0x3E,139,165,220,196,0x06,0x3F,147,175,220,0,0x07,0x0F,147,196,233,0,0x20,0x0F,147,196,233,0,0x21,0x0F,165,208,247,147,0x22,0x3E,165,208,247,147,0x23,0x3E,175,220,262,0,0x24,0x2F,175,220,262,0,0x25,0x2F,165,208,247,147,0x26,0x3E,165,208,247,147,0x27,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E,147,175,220,0,0x40,0x0F,131,165,220,0,0x41,0x3E,165,208,247,147,0x42,0x3F,131,165,220,0,0x43,0x3E,147,175,220,0,0x44,0x0F,131,165,220,0,0x45,0x3E,165,208,247,147,0x46,0x3F,131,165,220,0,0x47,0x3E};
+
@@ -0,0 +1,7 @@
+// generated by songdir.py from song names and tags; do not edit
+#define SONG_VIEW_COUNT 1
+const struct song_entry song_directory [19] = {{0,"000",0},{1,"001",0},{2,"002",0},{3,"003",0},{4,"004",0},{5,"005",0},{6,"006",0},{7,"007",0},{8,"008",0},{9,"009",0},{10,"010",0},{11,"011",0},{12,"012",0},{13,"013",0},{14,"014",0},{15,"015",0},{17,"back to black",0},{16,"new day for you",0},{18,"you know I'm no good",0}};
+const uint16_t song_view_index [19] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18};
+const struct song_view song_views [SONG_VIEW_COUNT] = {{"all",0,19}};
+const uint8_t song_steps_per_bar [19] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
+
@@ -0,0 +1,11 @@
+// generated by songpack.py from song data; do not edit
+#define SONG_PACKED_NOTE_BITS 7
+#define SONG_PACKED_COLOR_BITS 2
+#define SONG_PACKED_SEEK_INTERVAL 16
+constexpr uint16_t song_notes [66] = {0,65,69,73,78,82,87,92,98,104,110,117,123,131,139,147,156,165,175,185,196,208,220,233,247,262,277,294,311,330,349,370,392,415,440,466,494,523,554,587,622,659,698,740,784,831,880,932,988,1046,1109,1175,1244,1318,1397,1480,1568,1661,1760,1865,1976,2093,2218,2349,2489,2637};
+constexpr uint8_t song_colors [4] = {62,63,15,47};
+constexpr uint16_t song_instruments [60] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,1,1,0,0,0,0,0,0,0,0};
+constexpr uint16_t song_seek [77] = {840,1005,1170,1335,840,1005,1170,1335,420,569,840,1005,1170,1335,840,1005,1170,1335,840,1005,1170,1335,420,569,840,1005,1170,1335,840,1005,1170,1335,840,1005,1170,1335,420,569,840,1005,1170,1335,840,1005,1170,1335,840,1005,1170,1335,420,569,840,1005,1170,1335,196,306,416,519,629,739,842,952,1062,1172,1282,252,392,532,672,150,260,370,480,597,707};
+constexpr struct packed_song song_table [19] = {{3,6,4,56,0,0,0},{3,6,4,56,3,4,1421},{3,5,4,28,6,8,2842},{3,6,4,56,9,10,3521},{3,6,4,56,12,14,4942},{3,6,4,56,15,18,6363},{3,5,4,28,18,22,7784},{3,6,4,56,21,24,8463},{3,6,4,56,24,28,9884},{3,6,4,56,27,32,11305},{3,5,4,28,30,36,12726},{3,6,4,56,33,38,13405},{3,6,4,56,36,42,14826},{3,6,4,56,39,46,16247},{3,5,4,28,42,50,17668},{3,6,4,56,45,52,18347},{4,3,7,176,48,56,19768},{4,4,7,58,52,67,21160},{4,3,6,96,56,71,21930}};
+constexpr uint8_t song_bits [2848] = {129,161,193,12,129,198,48,132,24,74,208,44,104,26,67,143,25,8,141,100,136,50,84,161,185,208,100,134,54,51,28,26,207,16,104,40,68,51,162,41,13,157,102,80,52,170,33,214,80,139,230,69,35,24,34,204,20,104,14,67,137,33,5,13,131,198,49,4,153,137,208,76,134,42,67,22,26,12,141,102,136,51,211,161,249,12,133,134,68,52,36,26,211,16,106,38,69,179,26,106,13,185,104,96,52,0,0,1,5,14,36,88,208,232,17,8,210,164,74,151,50,109,234,8,244,24,146,40,178,228,201,148,171,193,172,95,199,158,93,251,118,14,192,142,30,63,130,32,134,20,59,6,74,182,172,217,179,104,211,170,2,175,102,221,218,245,107,88,230,120,112,249,243,233,215,183,127,127,48,84,152,49,208,32,134,20,67,11,154,6,205,99,40,50,35,161,161,12,89,134,46,52,25,154,205,80,103,198,67,3,26,18,13,141,104,74,52,167,161,212,140,138,134,53,228,26,122,209,196,104,8,67,134,153,3,77,98,104,49,196,160,113,208,64,134,36,51,19,154,202,208,101,8,67,163,161,225,12,121,102,62,52,161,161,209,16,137,198,68,131,26,82,205,172,104,90,67,175,33,24,141,140,6,0,32,160,192,129,4,11,26,61,2,65,154,84,233,82,166,77,29,129,30,67,18,69,150,60,153,114,53,152,245,235,216,179,107,223,206,1,216,209,227,71,16,196,144,98,199,64,201,150,53,123,22,109,90,85,224,213,172,91,187,126,13,203,28,15,46,127,62,253,250,246,239,23,134,14,51,8,26,197,16,99,168,65,243,160,137,12,77,102,40,52,150,33,204,80,134,102,67,211,25,250,204,128,104,68,67,164,161,18,205,137,38,53,180,154,97,209,184,134,96,67,49,154,25,13,0,32,80,112,144,176,208,244,4,130,154,170,186,202,218,234,4,122,134,18,69,75,79,83,215,193,236,239,241,243,245,247,13,67,136,153,4,205,98,168,49,228,160,129,208,72,134,40,51,21,154,203,80,102,72,67,195,161,241,12,129,102,66,52,163,161,210,144,137,6,69,163,26,98,205,180,104,94,67,177,33,25,13,141,230,48,148,152,81,208,48,134,28,67,15,154,8,205,100,168,50,99,161,193,12,105,134,54,52,29,154,207,80,104,70,68,67,26,50,13,157,104,82,52,171,161,214,140,139,6,54,36,27,154,209,212,104,0,0,2,10,28,72,176,160,209,35,16,164,73,149,46,101,218,212,17,232,49,36,81,100,201,147,41,87,131,89,191,142,61,187,246,237,28,128,29,61,126,4,65,12,41,118,12,148,108,89,179,103,209,166,85,5,94,205,186,181,235,215,176,204,241,224,242,231,211,175,111,255,62,98,72,49,179,160,105,12,61,134,32,52,18,26,202,144,101,230,66,147,25,218,12,113,104,60,52,160,33,209,204,136,166,52,116,26,66,209,168,104,88,67,174,153,23,77,108,104,54,68,163,177,209,36,134,22,51,12,26,199,16,100,40,66,51,161,169,12,93,102,48,52,154,33,206,80,135,230,67,19,26,26,205,144,104,76,67,168,161,20,205,138,166,53,244,154,129,209,200,134,104,67,53,154,27,13,0,64,64,129,3,9,22,52,122,4,130,52,169,210,165,76,155,58,2,61,134,36,138,44,121,50,229,106,48,235,215,177,103,215,190,157,3,176,163,199,143,32,136,33,197,142,129,146,45,107,246,44,218,180,170,192,171,89,183,118,253,26,150,57,30,92,254,124,250,245,237,223,87,12,49,102,26,52,143,161,200,144,132,134,66,99,25,194,204,100,104,54,67,157,33,15,13,136,70,52,68,154,41,209,156,134,82,67,42,26,22,141,107,8,54,19,163,153,13,213,134,108,52,56,154,197,80,99,198,65,3,25,146,12,77,104,42,52,151,161,204,140,134,134,51,228,25,250,208,132,104,70,67,165,25,19,13,106,72,53,180,162,105,209,188,134,98,51,50,26,218,144,109,232,70,147,163,1,0,8,40,112,32,193,130,70,143,64,144,38,85,186,148,105,83,71,160,199,144,68,145,37,79,166,92,13,102,253,58,246,236,218,183,115,0,118,244,248,17,4,49,164,216,49,80,178,101,205,158,69,155,86,21,120,53,235,214,174,95,195,50,199,131,203,159,79,191,190,253,251,140,33,199,204,131,38,50,52,25,162,208,88,104,48,67,154,153,13,77,103,232,51,4,162,17,209,144,134,76,51,39,154,212,208,106,136,69,227,162,129,13,201,102,102,52,181,161,219,16,142,70,71,3,0,8,20,28,36,44,52,61,129,160,166,170,174,178,182,58,129,158,161,68,209,210,211,212,117,48,251,123,252,124,253,253,192,208,96,134,64,99,24,66,12,37,104,22,52,141,161,199,12,132,70,50,68,25,170,208,92,104,50,67,155,25,14,141,103,8,52,20,162,25,209,148,134,78,51,40,26,213,16,107,168,69,243,162,17,12,17,102,10,52,135,161,196,144,130,134,65,227,24,130,204,68,104,38,67,149,33,11,13,134,70,51,196,153,233,208,124,134,66,67,34,26,18,141,105,8,53,147,162,89,13,181,134,92,52,48,26,0,128,128,2,7,18,44,104,244,8,4,105,82,165,75,153,54,117,4,122,12,73,20,89,242,100,202,213,96,214,175,99,207,174,125,59,7,96,71,143,31,65,16,67,138,29,3,37,91,214,236,89,180,105,85,129,87,179,110,237,250,53,44,115,60,184,252,249,244,235,219,191,31,160,25,12,21,134,12,52,8,26,197,16,99,166,65,243,24,138,12,73,104,40,52,150,33,204,76,134,102,51,212,25,242,208,128,104,68,67,164,153,18,205,105,40,53,164,162,97,209,184,134,96,51,2,26,194,144,97,232,64,147,160,89,12,53,102,28,52,144,33,201,208,132,166,66,115,25,202,204,104,104,56,67,158,161,15,77,136,102,52,84,154,49,209,160,134,84,67,43,154,22,205,107,40,54,3,0,16,80,224,64,130,5,141,30,129,32,77,170,116,41,211,166,142,64,143,33,137,34,75,158,76,185,26,204,250,117,236,217,181,111,231,0,236,232,241,35,8,98,72,177,99,160,100,203,154,61,139,54,173,42,240,106,214,173,93,191,134,101,142,7,151,63,159,126,125,251,247,7,52,133,161,195,16,130,70,65,195,24,114,204,60,104,34,67,147,33,10,141,133,6,51,164,153,217,208,116,134,62,67,32,26,17,13,105,200,52,115,162,73,13,173,134,88,52,46,26,216,144,108,134,64,99,24,66,12,37,104,22,52,141,161,199,12,132,70,50,68,25,170,208,92,104,50,67,155,25,14,141,103,8,52,20,162,25,209,148,134,78,51,40,26,213,16,107,168,69,243,162,137,13,205,102,0,0,2,10,28,72,176,160,209,35,16,164,73,149,46,101,218,212,17,232,49,36,81,100,201,147,41,87,131,89,191,142,61,187,246,237,28,128,29,61,126,4,65,12,41,118,12,148,108,89,179,103,209,166,85,5,94,205,186,181,235,215,176,204,241,224,242,231,211,175,111,255,126,129,230,48,148,24,82,208,48,104,28,67,144,153,8,205,100,168,50,100,161,193,208,104,134,56,51,29,154,207,80,104,72,68,67,162,49,13,161,102,82,52,171,161,214,144,139,6,70,35,27,162,205,0,0,2,5,7,9,11,77,79,32,168,169,170,171,172,173,78,160,103,40,81,180,244,52,117,29,204,254,30,63,95,127,223,64,131,24,82,12,45,104,26,52,143,161,200,140,132,134,50,100,25,186,208,100,104,54,67,157,25,15,13,104,72,52,52,162,41,209,156,134,82,51,42,26,214,144,107,232,69,19,163,153,13,213,102,14,52,137,161,197,16,131,198,65,3,25,146,204,76,104,42,67,151,33,12,141,134,134,51,228,153,249,208,132,134,70,67,36,26,19,13,106,72,53,179,162,105,13,189,134,96,52,50,26,218,144,109,6,0,32,160,192,129,4,11,26,61,2,65,154,84,233,82,166,77,29,129,30,67,18,69,150,60,153,114,53,152,245,235,216,179,107,223,206,1,216,209,227,71,16,196,144,98,199,64,201,150,53,123,22,109,90,85,224,213,172,91,187,126,13,203,28,15,46,127,62,253,250,246,239,35,104,20,67,140,161,6,205,131,38,50,52,153,161,208,88,134,48,67,25,154,13,77,103,232,51,3,162,17,13,145,134,74,52,39,154,212,208,106,134,69,227,26,130,13,197,104,102,52,181,161,219,76,130,102,49,212,24,114,208,64,104,36,67,148,153,10,205,101,40,51,164,161,225,208,120,134,64,51,33,154,209,80,105,200,68,131,162,81,13,177,102,90,52,175,161,216,144,140,134,70,99,27,194,205,0,0,4,20,56,144,96,65,163,71,32,72,147,42,93,202,180,169,35,208,99,72,162,200,146,39,83,174,6,179,126,29,123,118,237,219,57,0,59,122,252,8,130,24,82,236,24,40,217,178,102,207,162,77,171,10,188,154,117,107,215,175,97,153,227,193,229,207,167,95,223,254,125,5,13,99,200,49,244,160,137,208,76,134,42,51,22,26,204,144,102,104,67,211,161,249,12,133,102,68,52,164,33,211,208,137,38,69,179,26,106,205,184,104,96,67,178,161,25,77,141,230,54,148,155,89,208,52,134,30,67,16,26,9,13,101,200,50,115,161,201,12,109,134,56,52,30,26,208,144,104,102,68,83,26,58,13,161,104,84,52,172,33,215,204,139,38,54,52,27,162,209,216,104,112,67,186,25,0,128,128,2,7,18,44,104,244,8,4,105,82,165,75,153,54,117,4,122,12,73,20,89,242,100,202,213,96,214,175,99,207,174,125,59,7,96,71,143,31,65,16,67,138,29,3,37,91,214,236,89,180,105,85,129,87,179,110,237,250,53,44,115,60,184,252,249,244,235,219,191,207,160,113,12,65,134,34,52,19,154,202,208,101,6,67,163,25,226,12,117,104,62,52,161,161,209,12,137,198,52,132,26,74,209,172,104,90,67,175,25,24,141,108,136,54,84,163,185,209,228,134,118,51,0,128,64,193,65,194,66,211,19,8,106,170,234,42,107,171,19,232,25,74,20,45,61,77,93,7,179,191,199,207,215,223,15,208,12,134,10,67,6,26,4,141,98,136,49,211,160,121,12,69,134,36,52,20,26,203,16,102,38,67,179,25,234,12,121,104,64,52,162,33,210,76,137,230,52,148,26,82,209,176,104,92,67,176,25,1,13,97,200,48,116,160,73,208,44,134,26,51,14,26,200,144,100,104,66,83,161,185,12,101,102,52,52,156,33,207,208,135,38,68,51,26,42,205,152,104,80,67,170,161,21,77,139,230,53,20,155,1,0,8,40,112,32,193,130,70,143,64,144,38,85,186,148,105,83,71,160,199,144,68,145,37,79,166,92,13,102,253,58,246,236,218,183,115,0,118,244,248,17,4,49,164,216,49,80,178,101,205,158,69,155,86,21,120,53,235,214,174,95,195,50,199,131,203,159,79,191,190,253,251,160,1,97,176,25,16,6,157,1,129,235,33,12,8,35,252,64,156,33,12,192,155,1,193,11,129,96,24,78,197,85,76,0,226,42,166,226,42,38,0,113,21,83,113,21,33,16,12,195,169,184,138,16,8,134,225,84,92,69,182,140,99,182,180,237,4,10,166,96,10,210,117,2,16,87,49,21,87,49,1,136,171,152,138,171,152,0,196,85,76,197,85,132,64,48,12,167,226,42,178,101,28,179,165,109,51,176,50,142,217,210,182,19,40,152,130,41,72,215,9,64,92,197,84,92,197,4,32,174,98,42,174,34,4,130,97,56,21,87,49,129,130,41,152,130,116,205,192,202,56,102,75,219,102,96,101,28,179,165,109,51,176,50,142,217,210,182,25,88,25,199,108,105,219,155,1,193,187,41,12,186,155,65,161,171,25,20,188,6,66,33,110,40,16,226,6,194,96,174,32,12,222,10,194,96,0,2,4,165,115,16,32,40,157,131,0,65,233,28,4,8,74,231,32,64,80,58,7,1,130,210,57,8,16,148,206,65,128,160,116,14,2,4,165,115,16,32,40,157,147,32,69,235,157,4,41,90,239,184,11,8,16,148,206,65,128,160,116,14,58,60,6,66,125,20,67,234,24,10,63,66,12,183,132,24,206,6,81,168,16,32,84,97,56,84,225,8,20,143,35,207,143,35,4,44,215,18,46,215,18,2,132,42,12,135,42,28,129,226,113,228,249,113,132,128,229,90,194,229,90,66,228,114,45,33,114,185,150,16,32,84,97,56,84,225,8,20,143,35,207,143,35,4,44,215,18,46,215,18,2,150,107,9,151,107,9,1,203,181,132,203,181,4,0,0,0,0};
+
@@ -0,0 +1,317 @@
+#include "songdata.hpp"
+
+#ifdef SONG_PACKED
+#include "song_packed.h"
+#else
+#include "song.h"
+#endif
+#include "song_dir.h"
+
+
+#ifndef SONG_PACKED
+
+// song data is parsed at compile time: any inconsistency in song.h is a build error rather than an error on stage,
+// and the position of the instruments and steps of each song is computed once, in song_offsets
+#define SONG_COUNT	(song [0])
+#define SONG_SIZE	((int) (sizeof (song) / sizeof (song [0])))
+
+struct song_offset {					// where the data of a song is in song []
+	uint16_t number_of_channels;		// number of channels in the song
+	uint16_t number_of_steps;			// number of steps in the song
+	uint16_t instruments;				// index of the instrument of channel 0
+	uint16_t steps;						// index of step 0
+};
+
+struct song_index {						// offsets of all the songs
+	struct song_offset songs [SONG_COUNT];
+};
+
+enum song_error_code {					// first inconsistency found in song data
+	SONG_OK,
+	SONG_NO_SONG,						// no song, or more songs than song indexes
+	SONG_BAD_POINTER,					// song index outside of song data
+	SONG_BAD_CHANNELS,					// no channel, or more channels than synth voices
+	SONG_NO_STEP,						// song without any step
+	SONG_TRUNCATED,						// song steps go beyond song data
+	SONG_BAD_INSTRUMENT,				// instrument number not lower than NB_INSTRUMENTS
+	SONG_END_MARKER,					// END note within a step
+	SONG_BAD_PAD						// pad number outside of the 8x8 grid (0x00 to 0x77)
+};
+
+
+// check song data; returns the first inconsistency found, SONG_OK if there is none
+constexpr int song_error (void)
+{
+	if ((SONG_SIZE < 1) || (SONG_COUNT == 0) || (1 + SONG_COUNT > SONG_SIZE)) return SONG_NO_SONG;
+
+	for (int num = 0; num < SONG_COUNT; num++) {
+		int pointer = song [1 + num];
+		if ((pointer < 1 + SONG_COUNT) || (pointer + 2 > SONG_SIZE)) return SONG_BAD_POINTER;
+
+		int channels = song [pointer];
+		int steps = song [pointer + 1];
+		if ((channels == 0) || (channels > CHANNEL_COUNT)) return SONG_BAD_CHANNELS;
+		if (steps == 0) return SONG_NO_STEP;
+		if (pointer + 2 + channels + (steps * (channels + 2)) > SONG_SIZE) return SONG_TRUNCATED;
+
+		for (int i = 0; i < channels; i++) {
+			if (song [pointer + 2 + i] >= NB_INSTRUMENTS) return SONG_BAD_INSTRUMENT;
+		}
+
+		pointer += 2 + channels;
+		for (int position = 0; position < steps; position++) {
+			for (int i = 0; i < channels; i++) {
+				if (song [pointer++] == 0xFFFF) return SONG_END_MARKER;
+			}
+			if ((song [pointer] > 0x77) || ((song [pointer] & 0x0F) > 7)) return SONG_BAD_PAD;
+			pointer += 2;
+		}
+	}
+	return SONG_OK;
+}
+
+constexpr int song_data_error = song_error ();
+static_assert (song_data_error != SONG_NO_SONG, "song.h: no song, or more songs than song indexes");
+static_assert (song_data_error != SONG_BAD_POINTER, "song.h: song index outside of song data");
+static_assert (song_data_error != SONG_BAD_CHANNELS, "song.h: song without channel, or with more channels than CHANNEL_COUNT");
+static_assert (song_data_error != SONG_NO_STEP, "song.h: song without any step");
+static_assert (song_data_error != SONG_TRUNCATED, "song.h: song steps go beyond song data");
+static_assert (song_data_error != SONG_BAD_INSTRUMENT, "song.h: instrument number out of range (NB_INSTRUMENTS)");
+static_assert (song_data_error != SONG_END_MARKER, "song.h: END note within a step");
+static_assert (song_data_error != SONG_BAD_PAD, "song.h: pad number outside of 0x00 - 0x77 grid");
+
+
+// offsets of the instruments and steps of each song
+constexpr struct song_index song_index_of (void)
+{
+	struct song_index index = {};
+
+	for (int num = 0; num < SONG_COUNT; num++) {
+		int pointer = song [1 + num];
+		index.songs [num].number_of_channels = song [pointer];
+		index.songs [num].number_of_steps = song [pointer + 1];
+		index.songs [num].instruments = pointer + 2;
+		index.songs [num].steps = pointer + 2 + song [pointer];
+	}
+	return index;
+}
+
+constexpr struct song_index song_offsets = song_index_of ();
+
+
+// number of songs in song data
+int song_count (void)
+{
+	return SONG_COUNT;
+}
+
+
+// get number of channels and number of steps of song NUM
+// returns false if song does not exist
+bool get_song_info (int num, int* number_of_channels, int* number_of_steps)
+{
+	// check if song exists by checking that song number is lower than number of songs
+	if ((num < 0) || (num >= SONG_COUNT)) return false;
+
+	*number_of_channels = song_offsets.songs [num].number_of_channels;
+	*number_of_steps = song_offsets.songs [num].number_of_steps;
+	return true;
+}
+
+
+// get instrument number of channel CHAN of song NUM
+int get_song_instrument (int num, int chan)
+{
+	return song [song_offsets.songs [num].instruments + chan];
+}
+
+
+// get step data from the song and fill the step structure accordingly
+// num is the song number, position is the step number
+// returns true if step data is OK, false otherwise
+// song data has been checked at compile time: only NUM and POSITION need to be checked
+bool get_step (int num, int position, struct songstep* step)
+{
+const struct song_offset* offset;
+int pointer;
+int i;
+
+
+	// check if song exists by checking that song number is lower than number of songs
+	if ((num < 0) || (num >= SONG_COUNT)) return false;
+	offset = &song_offsets.songs [num];
+
+	step->number_of_channels = offset->number_of_channels;
+	step->number_of_steps = offset->number_of_steps;
+
+	// determine if we are still within the song; if not, return false
+	if ((position < 0) || (position >= step->number_of_steps)) return false;
+
+	// pointer to step data
+	pointer = offset->steps + (position * (step->number_of_channels + 2));	// nb_chan + 2 as we need to skip pad number and color
+
+	// get song data (at position) and load structure with it
+	for (i = 0; i < step->number_of_channels; i++) step->notes [i] = song [pointer++];
+
+	// fill pad number and pad color, and obviously step number
+	step->pad_number = song [pointer++];
+	step->pad_color = song [pointer];
+	step->step_number = position;
+
+	return true;
+}
+
+#else
+
+// the song table is checked at compile time, as song.h is
+constexpr bool packed_songs_valid (void)
+{
+	for (const struct packed_song& packed : song_table) {
+		if ((packed.number_of_channels == 0) || (packed.number_of_channels > CHANNEL_COUNT) || (packed.number_of_steps == 0)) return false;
+		for (int i = 0; i < packed.number_of_channels; i++) {
+			if (song_instruments [packed.instruments + i] >= NB_INSTRUMENTS) return false;
+		}
+	}
+	return true;
+}
+static_assert (packed_songs_valid (), "song_packed.h: channel count or instrument number out of range");
+
+
+// read COUNT bits (up to 24) at bit POSITION of the packed bit stream
+static inline uint32_t read_bits (uint32_t position, int count)
+{
+	const uint8_t *p = &song_bits [position >> 3];
+	uint32_t word = p [0] | (p [1] << 8) | (p [2] << 16) | (uint32_t (p [3]) << 24);
+
+	return (word >> (position & 7)) & ((1u << count) - 1);
+}
+
+
+// pad following a pad on the launchpad grid: next column, or first column of next row
+static inline uint32_t next_pad (uint32_t pad)
+{
+	if ((pad & 0x0F) < 7) return pad + 1;
+	return (pad & 0xF0) + 0x10;
+}
+
+
+// number of songs in song data
+int song_count (void)
+{
+	return sizeof (song_table) / sizeof (song_table [0]);
+}
+
+
+// get number of channels and number of steps of song NUM
+// returns false if song does not exist
+bool get_song_info (int num, int* number_of_channels, int* number_of_steps)
+{
+	if ((num < 0) || (num >= song_count ())) return false;
+
+	*number_of_channels = song_table [num].number_of_channels;
+	*number_of_steps = song_table [num].number_of_steps;
+	return true;
+}
+
+
+// get instrument number of channel CHAN of song NUM
+int get_song_instrument (int num, int chan)
+{
+	return song_instruments [song_table [num].instruments + chan];
+}
+
+
+// get step data from the song and fill the step structure accordingly
+// num is the song number, position is the step number
+// returns true if step data is OK, false otherwise
+// steps are decoded from the nearest seek point, so that at most SONG_PACKED_SEEK_INTERVAL steps are decoded
+bool get_step (int num, int position, struct songstep* step)
+{
+const struct packed_song *packed;
+uint32_t bit;
+uint32_t chord = 0, color = 0, pad = 0;
+int i, note, delta;
+
+
+	// check if song exists by checking that song number is lower than number of songs
+	if ((num < 0) || (num >= song_count ())) return false;
+	packed = &song_table [num];
+
+	step->number_of_channels = packed->number_of_channels;
+	step->number_of_steps = packed->number_of_steps;
+
+	// determine if we are still within the song; if not, return false
+	if ((position < 0) || (position >= step->number_of_steps)) return false;
+
+	// go to the seek point before the step, then decode steps up to the step
+	bit = packed->chords + song_seek [packed->seek + (position / SONG_PACKED_SEEK_INTERVAL)];
+	for (i = position - (position % SONG_PACKED_SEEK_INTERVAL); i <= position; i++) {
+		chord = read_bits (bit, packed->chord_bits);
+		bit += packed->chord_bits;
+		color = read_bits (bit, SONG_PACKED_COLOR_BITS);
+		bit += SONG_PACKED_COLOR_BITS;
+		if (read_bits (bit++, 1)) pad = next_pad (pad);
+		else {
+			pad = read_bits (bit, 7);
+			bit += 7;
+		}
+	}
+
+	// get chord from song chord dictionary: note of channel 0, then note deltas between channels
+	bit = packed->chords + chord * (SONG_PACKED_NOTE_BITS + (packed->number_of_channels - 1) * packed->delta_bits);
+	note = read_bits (bit, SONG_PACKED_NOTE_BITS);
+	bit += SONG_PACKED_NOTE_BITS;
+	for (i = 0; i < step->number_of_channels; i++) {
+		if (i) {
+			delta = read_bits (bit, packed->delta_bits);
+			bit += packed->delta_bits;
+			if (delta & (1 << (packed->delta_bits - 1))) delta -= (1 << packed->delta_bits);	// sign extension
+			note += delta;
+		}
+		step->notes [i] = song_notes [note];
+		// make sure we are not at the end of the song
+		if (step->notes [i] == 0xFFFF) return false;
+	}
+
+	// fill pad number and pad color, and obviously step number
+	step->pad_number = pad;
+	step->pad_color = song_colors [color];
+	step->step_number = position;
+
+	return true;
+}
+
+#endif
+
+
+// number of views of the song directory
+int song_view_count (void)
+{
+	return SONG_VIEW_COUNT;
+}
+
+
+// get view VIEW of the song directory; returns NULL if view does not exist
+const struct song_view* get_song_view (int view)
+{
+	if ((view < 0) || (view >= SONG_VIEW_COUNT)) return NULL;
+	return &song_views [view];
+}
+
+
+// get song directory entry at position POSITION of view VIEW, in constant time
+// returns NULL if there is no song at this position
+const struct song_entry* get_song_entry (int view, int position)
+{
+	if ((view < 0) || (view >= SONG_VIEW_COUNT)) return NULL;
+	if ((position < 0) || (position >= song_views [view].count)) return NULL;
+	return &song_directory [song_view_index [song_views [view].start + position]];
+}
+
+
+// number of steps per bar of song NUM, for the midi clock; 0 if the song is not played on a clock
+int get_song_steps_per_bar (int num)
+{
+	if ((num < 0) || (num >= (int) (sizeof (song_steps_per_bar) / sizeof (song_steps_per_bar [0])))) return 0;
+	return song_steps_per_bar [num];
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "synth.hpp"
+
+// access to song data, whatever the format it is stored in:
+// song.h (see songify.py), or song_packed.h when built with SONG_PACKED (see songpack.py)
+
+// number of instruments: instrument numbers in song data go from 0 to NB_INSTRUMENTS - 1
+#define NB_INSTRUMENTS 12
+
+// type definition
+struct songstep {
+	int step_number;					// current step number
+	int number_of_steps;				// number of steps in the song
+	int number_of_channels;				// number of channels in the song
+	uint16_t notes [CHANNEL_COUNT];		// channel data (ie. notes) for that step
+	uint8_t pad_number;					// pad number on the MIDI control surface
+	uint8_t pad_color;					// pad color on the MIDI control surface
+};
+
+struct packed_song {					// song entry of the packed format
+	uint8_t number_of_channels;			// number of channels in the song
+	uint8_t chord_bits;					// bits per chord index
+	uint8_t delta_bits;					// bits per note delta in chords
+	uint16_t number_of_steps;			// number of steps in the song
+	uint16_t instruments;				// index of song instruments in song_instruments
+	uint16_t seek;						// index of song seek index in song_seek
+	uint32_t chords;					// bit position of song chord dictionary in song_bits
+};
+
+struct song_entry {						// song directory entry (see songdir.py)
+	uint16_t song;						// song number
+	const char* name;					// song name
+	uint16_t tags;						// tags of the song: 1 bit per tag
+};
+
+struct song_view {						// view of the song directory: all songs, or songs having a given tag
+	const char* name;					// name of the view: "all" or tag name
+	uint16_t start;						// index of view entries in song_view_index
+	uint16_t count;						// number of songs in the view
+};
+
+int song_count (void);
+bool get_song_info (int num, int* number_of_channels, int* number_of_steps);
+int get_song_instrument (int num, int chan);
+bool get_step (int num, int position, struct songstep* step);
+int get_song_steps_per_bar (int num);
+
+// song directory, sorted by song name
+int song_view_count (void);
+const struct song_view* get_song_view (int view);
+const struct song_entry* get_song_entry (int view, int position);
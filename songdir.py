@@ -0,0 +1,109 @@
+# SONGDIR : build the song directory of Picopanion (song_dir.h)
+#
+# songify.py and songxls.py call write () with the name, the tags (see tagsOf) and the steps per bar (see barOf)
+# of each song, by song number: the bars give the song_steps_per_bar table below, the rest the directory
+#
+# song_dir.h contains:
+#
+# song_directory []		one entry per song, sorted by song name: song number, song name, tags (1 bit per tag)
+# song_view_index []	position of songs in song_directory, for each view
+# song_views []			views of the directory: view 0 is "all" songs, then one view per tag, holding the songs having this tag;
+#						each view is a name, and the start and number of its entries in song_view_index
+# song_steps_per_bar []	number of steps per bar of each song, by song number, for the midi clock; 0 if the song does not follow the clock
+#
+# Tags of a song are given in a row of the song, whose first cell starts with '#tags' (this row is a comment row for the song data):
+# #tags; band1; ballad		or		#tags band1, ballad
+#
+# Steps per bar of a song are given in a row whose first cell starts with '#bar' (a comment row as well); a song is then
+# played on the beat of a midi clock, one step every 96 / steps per bar clock ticks, so this must divide 96:
+# #bar; 4		or		#bar 4
+#
+# Load mode of Picopanion browses a view page by page (64 songs per page); the song of a pad is thus
+# song_directory [song_view_index [view start + page * 64 + pad]], whatever the number of songs.
+
+
+import re
+
+
+def tagsOf (rows):
+	# tags of a song, from its '#tags' rows
+	tags = []
+	for row in rows:
+		if len (row) == 0 or not str (row [0]).startswith ('#tags'):
+			continue
+		cells = [str (row [0]) [len ('#tags'):]] + [str (c) for c in row [1:]]
+		for cell in cells:
+			for tag in re.split (r'[,\s]+', cell.strip (' :')):
+				if tag != '' and tag not in tags:
+					tags.append (tag)
+	return tags
+
+
+def barOf (rows):
+	# steps per bar of a song, from its '#bar' row; 0 if there is none
+	for row in rows:
+		if len (row) == 0 or not str (row [0]).startswith ('#bar'):
+			continue
+		cells = [str (row [0]) [len ('#bar'):]] + [str (c) for c in row [1:]]
+		for cell in cells:
+			cell = cell.strip (' :')
+			if cell == '':
+				continue
+			steps = int (float (cell))
+			if steps <= 0 or 96 % steps != 0:
+				raise SystemExit ('steps per bar must divide 96: ' + cell)
+			return steps
+	return 0
+
+
+def nameOf (name):
+	# song name from a sheet or file name such as '016 new day for you'; the leading song number is removed
+	m = re.match (r'\s*\d+\s+(.+)', name)
+	if m:
+		return m.group (1).strip ()
+	return name.strip ()
+
+
+def cString (s):
+	return '"' + s.replace ('\\', '\\\\').replace ('"', '\\"') + '"'
+
+
+def write (names, tags, bars, fileName = 'song_dir.h'):
+	# names [i], tags [i] and bars [i] are the name, the list of tags and the steps per bar of song i
+	allTags = []
+	for songTags in tags:
+		for tag in songTags:
+			if tag not in allTags:
+				allTags.append (tag)
+	if len (allTags) > 16:
+		raise SystemExit ('too many song tags (16 max)')
+
+	# directory, sorted by song name
+	order = sorted (range (len (names)), key = lambda i: (names [i].lower (), i))
+	directory = []
+	for i in order:
+		bits = 0
+		for tag in tags [i]:
+			bits |= 1 << allTags.index (tag)
+		directory.append ((i, names [i], bits))
+
+	# views: all songs, then songs of each tag
+	index = []
+	views = []
+	for name, bit in [('all', None)] + [(t, 1 << n) for n, t in enumerate (allTags)]:
+		start = len (index)
+		for position, entry in enumerate (directory):
+			if bit is None or (entry [2] & bit):
+				index.append (position)
+		views.append ((name, start, len (index) - start))
+
+	s = '// generated by songdir.py from song names and tags; do not edit\n'
+	s += '#define SONG_VIEW_COUNT ' + str (len (views)) + '\n'
+	s += 'const struct song_entry song_directory [' + str (len (directory)) + '] = {' + ','.join ('{' + str (n) + ',' + cString (name) + ',' + str (bits) + '}' for n, name, bits in directory) + '};\n'
+	s += 'const uint16_t song_view_index [' + str (len (index)) + '] = {' + ','.join (str (i) for i in index) + '};\n'
+	s += 'const struct song_view song_views [SONG_VIEW_COUNT] = {' + ','.join ('{' + cString (name) + ',' + str (start) + ',' + str (count) + '}' for name, start, count in views) + '};\n'
+	s += 'const uint8_t song_steps_per_bar [' + str (len (bars)) + '] = {' + ','.join (str (b) for b in bars) + '};\n'
+
+	with open (fileName, 'wt') as f:
+		print (s, file = f)
+	f.close ()
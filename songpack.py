@@ -0,0 +1,192 @@
+# SONGPACK : pack song data for Picopanion into a compact format (song_packed.h)
+#
+# usage : songpack.py [song.h]
+#         packs an existing song.h; songify.py and songxls.py also call pack () directly
+#
+# song.h stores every step as (number of channels + 2) UINT16. The packed format stores:
+#
+# song_notes []			distinct note values (frequencies) of all songs; notes are stored as an index in this table
+# song_colors []			distinct pad colours of all songs; colours are stored as an index in this table
+# song_instruments []		instrument number of each channel, for all songs
+# song_table []				one entry per song: number of channels, number of steps, bits per chord index, bits per note delta,
+#							position of song instruments in song_instruments, position of song seek index in song_seek,
+#							bit position of song chord dictionary in song_bits
+# song_seek []				bit position of every SEEK_INTERVAL th step of each song, relative to the song chord dictionary
+# song_bits []				bit stream (LSB first) holding, for each song:
+#							- chord dictionary: each distinct chord of the song, as the note index of channel 0 (NOTE_BITS),
+#							  then for each other channel the signed difference with the note index of previous channel (delta bits)
+#							- steps: chord index (chord bits), colour index (COLOR_BITS), then a 1-bit flag:
+#							  1 if pad is the pad following previous step pad (next column, or first column of next row),
+#							  0 followed by 7-bit pad number otherwise. First step of a seek interval always has a 0 flag.
+#
+# Chords are fixed width, so a chord is read in O(1); a step is read by decoding at most
+# SEEK_INTERVAL - 1 steps from the nearest seek index entry.
+
+
+import re
+import sys
+
+
+SEEK_INTERVAL = 16
+
+
+def bitsFor (count):
+	# number of bits needed to store an index in a table of count elements (at least 1)
+	bits = 1
+	while (1 << bits) < count:
+		bits += 1
+	return bits
+
+
+def signedBitsFor (low, high):
+	# number of bits needed to store signed values from low to high (at least 1)
+	bits = 1
+	while low < -(1 << (bits - 1)) or high >= (1 << (bits - 1)):
+		bits += 1
+	return bits
+
+
+def nextPad (pad):
+	# pad following a pad on the launchpad grid: next column, or first column of next row
+	if (pad & 0x0F) < 7:
+		return pad + 1
+	return (pad & 0xF0) + 0x10
+
+
+class BitWriter:
+
+	def __init__ (self):
+		self.data = bytearray ()
+		self.position = 0
+
+	def write (self, value, count):
+		for i in range (count):
+			if (self.position >> 3) >= len (self.data):
+				self.data.append (0)
+			if (value >> i) & 1:
+				self.data [self.position >> 3] |= 1 << (self.position & 7)
+			self.position += 1
+
+
+def cArray (ctype, name, values):
+	return 'constexpr ' + ctype + ' ' + name + ' [' + str (len (values)) + '] = {' + ','.join (str (v) for v in values) + '};\n'
+
+
+def pack (data):
+	# data is the song.h content as a list; pad numbers and colours may be strings ('0x3E')
+	data = [int (x, 0) if isinstance (x, str) else int (x) for x in data]
+	numberOfSongs = data [0]
+
+	# first pass: read songs, build note and colour tables
+	songs = []
+	notes = []
+	colors = []
+	for num in range (numberOfSongs):
+		pointer = data [1 + num]
+		nbChan = data [pointer]
+		nbStep = data [pointer + 1]
+		instruments = data [pointer + 2:pointer + 2 + nbChan]
+		pointer += 2 + nbChan
+		steps = []
+		for i in range (nbStep):
+			step = data [pointer:pointer + nbChan + 2]
+			pointer += nbChan + 2
+			chord = tuple (step [:nbChan])
+			for note in chord:
+				if note not in notes:
+					notes.append (note)
+			if step [nbChan + 1] not in colors:
+				colors.append (step [nbChan + 1])
+			steps.append ((chord, step [nbChan], step [nbChan + 1]))
+		songs.append ((nbChan, instruments, steps))
+
+	notes.sort ()
+	noteBits = bitsFor (len (notes))
+	colorBits = bitsFor (len (colors))
+
+	# second pass: write chord dictionaries and steps
+	bits = BitWriter ()
+	table = []
+	allInstruments = []
+	seek = []
+	for nbChan, instruments, steps in songs:
+		chords = []
+		for chord, pad, color in steps:
+			if chord not in chords:
+				chords.append (chord)
+		chordBits = bitsFor (len (chords))
+
+		# chords are stored as note index differences between channels
+		deltas = [notes.index (chord [c]) - notes.index (chord [c - 1]) for chord in chords for c in range (1, nbChan)]
+		deltaBits = signedBitsFor (min (deltas + [0]), max (deltas + [0]))
+
+		start = bits.position
+		entry = [nbChan, chordBits, deltaBits, len (steps), len (allInstruments), len (seek), start]
+		allInstruments.extend (instruments)
+
+		# chord dictionary
+		for chord in chords:
+			bits.write (notes.index (chord [0]), noteBits)
+			for c in range (1, nbChan):
+				bits.write ((notes.index (chord [c]) - notes.index (chord [c - 1])) & ((1 << deltaBits) - 1), deltaBits)
+
+		# steps, with a seek index entry every SEEK_INTERVAL steps
+		previousPad = None
+		for i, (chord, pad, color) in enumerate (steps):
+			if i % SEEK_INTERVAL == 0:
+				if bits.position - start >= 0x10000:
+					sys.exit ('song too large for packed format')
+				seek.append (bits.position - start)
+				previousPad = None
+			bits.write (chords.index (chord), chordBits)
+			bits.write (colors.index (color), colorBits)
+			if previousPad is not None and pad == nextPad (previousPad):
+				bits.write (1, 1)
+			else:
+				bits.write (0, 1)
+				bits.write (pad, 7)
+			previousPad = pad
+		table.append (entry)
+
+	# 4 bytes of padding, so that the decoder may always read 4 bytes at once
+	songBits = list (bits.data) + [0, 0, 0, 0]
+
+	s = '// generated by songpack.py from song data; do not edit\n'
+	s += '#define SONG_PACKED_NOTE_BITS ' + str (noteBits) + '\n'
+	s += '#define SONG_PACKED_COLOR_BITS ' + str (colorBits) + '\n'
+	s += '#define SONG_PACKED_SEEK_INTERVAL ' + str (SEEK_INTERVAL) + '\n'
+	s += cArray ('uint16_t', 'song_notes', notes)
+	s += cArray ('uint8_t', 'song_colors', colors)
+	s += cArray ('uint16_t', 'song_instruments', allInstruments)
+	s += cArray ('uint16_t', 'song_seek', seek)
+	s += 'constexpr struct packed_song song_table [' + str (numberOfSongs) + '] = {' + ','.join ('{' + ','.join (str (v) for v in e) + '}' for e in table) + '};\n'
+	s += cArray ('uint8_t', 'song_bits', songBits)
+
+	# sizes, in bytes
+	rawSize = 2 * len (data)
+	packedSize = 2 * len (notes) + len (colors) + 2 * len (allInstruments) + 2 * len (seek) + 16 * len (table) + len (songBits)
+	print ('song data: ' + str (rawSize) + ' bytes, packed: ' + str (packedSize) + ' bytes (' + '%.1f' % (rawSize / packedSize) + 'x smaller)')
+
+	return s
+
+
+def write (data, fileName = 'song_packed.h'):
+	s = pack (data)
+	with open (fileName, 'wt') as f:
+		print (s, file = f)
+	f.close ()
+
+
+######
+# MAIN
+######
+
+if __name__ == '__main__':
+	fileName = sys.argv [1] if len (sys.argv) >= 2 else 'song.h'
+
+	# read song array from song.h
+	with open (fileName, 'rt') as f:
+		content = f.read ()
+	f.close ()
+	values = re.search (r'\{(.*)\}', content, re.S).group (1).split (',')
+	write ([int (v.strip (), 0) for v in values])
@@ -61,11 +61,13 @@
 import os
 import sys
 import csv
+import songpack
+import songdir
 import pandas as pd
 
 
 notes = {'':0, 'END':0xFFFF, 'BASS':500, 'SNARE':6000, 'HAT':20000, 'A0':27.5, 'A#0':29.135, 'BB0':29.135, 'B0':30.868, 'C1':32.703, 'C#1':34.648, 'DB1':34.648, 'D1':36.708, 'D#1':38.89, 'EB1':38.89, 'E1':41.203, 'F1':43.653, 'F#1':46.249, 'GB1':46.249, 'G1':49, 'G#1':51.913, 'AB1':51.913, 'A1':55, 'A#1':58.271, 'BB1':58.271, 'B1':61.735, 'C2':65.406, 'C#2':69.296, 'DB2':69.296, 'D2':73.416, 'D#2':77.781, 'EB2':77.781, 'E2':82.407, 'F2':87.307, 'F#2':92.499, 'GB2':92.499, 'G2':98, 'G#2':103.83, 'AB2':103.83, 'A2':110, 'A#2':116.54, 'BB2':116.54, 'B2':123.47, 'C3':130.81, 'C#3':138.59, 'DB3':138.59, 'D3':146.83, 'D#3':155.56, 'EB3':155.56, 'E3':164.81, 'F3':174.61, 'F#3':184.99, 'GB3':184.99, 'G3':195.99, 'G#3':207.65, 'AB3':207.65, 'A3':220, 'A#3':233.08, 'BB3':233.08, 'B3':246.94, 'C4':261.62, 'C#4':277.18, 'DB4':277.18, 'D4':293.66, 'D#4':311.12, 'EB4':311.12, 'E4':329.62, 'F4':349.22, 'F#4':369.99, 'GB4':369.99, 'G4':392, 'G#4':415.3, 'AB4':415.3, 'A4':440, 'A#4':466.16, 'BB4':466.16, 'B4':493.88, 'C5':523.25, 'C#5':554.37, 'DB5':554.37, 'D5':587.32, 'D#5':622.25, 'EB5':622.25, 'E5':659.26, 'F5':698.45, 'F#5':739.99, 'GB5':739.99, 'G5':783.99, 'G#5':830.61, 'AB5':830.61, 'A5':880, 'A#5':932.32, 'BB5':932.32, 'B5':987.77, 'C6':1046.5, 'C#6':1108.7, 'DB6':1108.7, 'D6':1174.7, 'D#6':1244.5, 'EB6':1244.5, 'E6':1318.5, 'F6':1396.9, 'F#6':1480, 'GB6':1480, 'G6':1568, 'G#6':1661.2, 'AB6':1661.2, 'A6':1760, 'A#6':1864.7, 'BB6':1864.7, 'B6':1975.5, 'C7':2093, 'C#7':2217.5, 'DB7':2217.5, 'D7':2349.3, 'D#7':2489, 'EB7':2489, 'E7':2637, 'F7':2793.8, 'F#7':2960, 'GB7':2960, 'G7':3136, 'G#7':3322.4, 'AB7':3322.4, 'A7':3520, 'A#7':3729.3, 'BB7':3729.3, 'B7':3951.1, 'C8':4186} 
-instr = {'':0, 'piano':0, 'piano2':1, 'reed':2, 'guitar':3, 'pluckedguitar':4, 'bass':5, 'violin':6, 'horn':7, 'oboe':8, 'clarinette':9, 'flute':10}
+instr = {'':0, 'piano':0, 'piano2':1, 'reed':2, 'guitar':3, 'pluckedguitar':4, 'bass':5, 'violin':6, 'horn':7, 'oboe':8, 'clarinette':9, 'flute':10, 'drums':11}
 color = {'':'0x00', 'green':'0x3C', 'red':'0x0F', 'amber':'0x3F', 'yellow':'0x3E', 'orange':'0x2F'}
 
 
@@ -76,6 +78,10 @@ def processSong (sng):
 	steps = []
 	result = []
 
+	# tags of the song, for the song directory
+	songTags.append (songdir.tagsOf (sng))
+	songBars.append (songdir.barOf (sng))
+
 	# first, go through the list and remove any list element with comment in the first cell
 	song = [item for item in sng if not item[0].startswith('!!') and not item[0].startswith('==') and not item[0].startswith('**') and not item[0].startswith('#') and not item[0].startswith('//')]
 
@@ -123,6 +129,9 @@ def processSong (sng):
 
 finalResult = []
 index = []
+songNames = []
+songTags = []
+songBars = []
 	
 # check if number of files to process
 if len (sys.argv) >= 2:
@@ -149,6 +158,7 @@ if len (sys.argv) >= 2:
 	# process song one after the other
 	for sheet in df:
 		print ('analyzing song ' + sheet)
+		songNames.append (songdir.nameOf (sheet))
 		
 		# df[sheet] contains all the xls sheet elements; convert this dataframe to a list then pass it to funct for processing
 		finalResult.extend (processSong (df [sheet].values.tolist()))
@@ -160,7 +170,7 @@ if len (sys.argv) >= 2:
 		finalResult [i+1] = index [i]
 
 	# format final result string
-	s = 'const uint16_t song ['
+	s = 'constexpr uint16_t song ['
 	s += str (len(finalResult))
 	s += '] = {'
 	for i in finalResult:
@@ -175,6 +185,12 @@ if len (sys.argv) >= 2:
 	with open("song.h", "wt") as f:
 		print (s, file=f)
 	f.close ()
+
+	# same song data, in packed format (song_packed.h)
+	songpack.write (finalResult)
+
+	# song directory, sorted by name (song_dir.h)
+	songdir.write (songNames, songTags, songBars)
 	
 else:
 	print ("\nusage : songxls.py excel_song_file\n")
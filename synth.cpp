@@ -1,8 +1,10 @@
+#include <cmath>
 #include "synth.hpp"
 
 namespace synth {
 
-  uint32_t prng_xorshift_state = 0x32B71700;
+  const uint32_t prng_seed = 0x32B71700;
+  uint32_t prng_xorshift_state = prng_seed;
 
   uint32_t prng_xorshift_next() {
     uint32_t x = prng_xorshift_state;
@@ -22,6 +24,7 @@ namespace synth {
   }
 
   uint16_t volume = 0xffff;
+  Limiter limiter;
   const int16_t sine_waveform [256] = {-32768,-32758,-32729,-32679,-32610,-32522,-32413,-32286,-32138,-31972,-31786,-31581,-31357,-31114,-30853,-30572,-30274,-29957,-29622,-29269,-28899,-28511,-28106,-27684,-27246,-26791,-26320,-25833,-25330,-24812,-24279,-23732,-23170,-22595,-22006,-21403,-20788,-20160,-19520,-18868,-18205,-17531,-16846,-16151,-15447,-14733,-14010,-13279,-12540,-11793,-11039,-10279,-9512,-8740,-7962,-7180,-6393,-5602,-4808,-4011,-3212,-2411,-1608,-804,0,804,1608,2411,3212,4011,4808,5602,6393,7180,7962,8740,9512,10279,11039,11793,12540,13279,14010,14733,15447,16151,16846,17531,18205,18868,19520,20160,20788,21403,22006,22595,23170,23732,24279,24812,25330,25833,26320,26791,27246,27684,28106,28511,28899,29269,29622,29957,30274,30572,30853,31114,31357,31581,31786,31972,32138,32286,32413,32522,32610,32679,32729,32758,32767,32758,32729,32679,32610,32522,32413,32286,32138,31972,31786,31581,31357,31114,30853,30572,30274,29957,29622,29269,28899,28511,28106,27684,27246,26791,26320,25833,25330,24812,24279,23732,23170,22595,22006,21403,20788,20160,19520,18868,18205,17531,16846,16151,15447,14733,14010,13279,12540,11793,11039,10279,9512,8740,7962,7180,6393,5602,4808,4011,3212,2411,1608,804,0,-804,-1608,-2411,-3212,-4011,-4808,-5602,-6393,-7180,-7962,-8740,-9512,-10279,-11039,-11793,-12540,-13279,-14010,-14733,-15447,-16151,-16846,-17531,-18205,-18868,-19520,-20160,-20788,-21403,-22006,-22595,-23170,-23732,-24279,-24812,-25330,-25833,-26320,-26791,-27246,-27684,-28106,-28511,-28899,-29269,-29622,-29957,-30274,-30572,-30853,-31114,-31357,-31581,-31786,-31972,-32138,-32286,-32413,-32522,-32610,-32679,-32729,-32758};
   const int16_t violin_waveform [256] = {-3066,-1662,-345,917,2135,3301,4409,5504,6500,7490,8429,9308,10123,10899,11600,12250,12843,13370,13808,14187,14480,14674,14777,14774,14678,14511,14257,13905,13403,12702,11749,10440,8818,7175,5863,4896,4236,3760,3439,3245,3236,3459,3927,4684,5738,7125,8854,10954,13412,16149,19094,22071,24930,27487,29595,31181,32229,32741,32767,32291,31329,29904,28072,25916,23469,20861,18166,15449,12774,10268,7938,5821,3948,2362,1048,13,-738,-1208,-1405,-1403,-1234,-866,-273,587,1739,3221,4992,7006,9050,10995,12642,14020,15064,15803,16301,16582,16672,16574,16275,15766,15051,14100,12918,11527,9886,7989,5900,3604,1117,-1505,-4237,-7050,-9874,-12676,-15425,-18054,-20502,-22750,-24813,-26645,-28239,-29572,-30683,-31541,-32168,-32579,-32767,-32766,-32661,-32449,-32097,-31619,-30926,-30063,-28917,-27574,-25971,-24297,-22733,-21381,-20353,-19634,-19174,-18938,-18877,-18973,-19192,-19525,-19938,-20454,-20995,-21615,-22253,-22953,-23645,-24350,-25056,-25784,-26462,-27111,-27746,-28304,-28823,-29282,-29632,-29898,-29987,-29788,-29310,-28579,-27623,-26471,-25201,-23856,-22471,-21077,-19665,-18319,-17025,-15795,-14604,-13493,-12467,-11496,-10583,-9759,-8968,-8264,-7595,-7010,-6460,-5967,-5530,-5127,-4778,-4478,-4211,-3991,-3803,-3650,-3537,-3461,-3416,-3399,-3409,-3456,-3575,-3807,-4089,-4202,-4175,-3954,-3644,-3379,-3183,-3059,-2970,-2941,-3094,-3525,-3994,-4335,-4543,-4651,-4693,-4688,-4669,-4632,-4577,-4496,-4384,-4222,-4018,-3822,-3707,-3663,-3659,-3682,-3750,-3875,-4077,-4344,-4728,-5152,-5589,-5941,-6126,-6184,-6111,-5942,-5693,-5361,-4984,-4586,-4113,-3620};
   const int16_t reed_waveform [256] = {-1080,-695,-340,0,328,651,957,1264,1555,1840,2117,2385,2640,2899,3144,3374,3606,3838,4070,4285,4483,4697,4894,5089,5267,5458,5632,5804,5974,6126,6291,6438,6583,6725,6865,7001,7134,7251,7366,7489,7597,7702,7803,7901,7985,8077,8164,8241,8333,8432,8549,8673,8807,8948,9098,9269,9461,9663,9875,10097,10359,10616,10917,11212,11553,11907,12311,12728,13178,13662,14203,14780,15393,16089,16847,17689,18616,19651,20814,22144,23648,25314,27104,28826,30311,31395,32128,32570,32767,32507,31644,30065,27644,24352,20191,15378,10327,5369,866,-3081,-6429,-9206,-11482,-13309,-14740,-15828,-16618,-17146,-17438,-17519,-17409,-17171,-16900,-16603,-16293,-15972,-15648,-15312,-14968,-14640,-14298,-13966,-13635,-13306,-12968,-12647,-12333,-12026,-11712,-11408,-11097,-10797,-10507,-10213,-9932,-9646,-9374,-9098,-8836,-8554,-8304,-8034,-7780,-7523,-7263,-7020,-6775,-6528,-6298,-6048,-5815,-5580,-5364,-5126,-4907,-4686,-4465,-4242,-4017,-3813,-3607,-3379,-3171,-2962,-2774,-2563,-2373,-2160,-1968,-1776,-1582,-1344,-1033,-722,-386,-50,284,644,1028,1435,1865,2291,2762,3252,3758,4301,4878,5503,6147,6801,7491,8161,8796,9365,9831,10178,10427,10582,10661,10593,9991,9221,8243,6993,5352,3092,-289,-6332,-17203,-23626,-26908,-28997,-30417,-31454,-32211,-32767,-32728,-32295,-31768,-31149,-30422,-29593,-28660,-27636,-26544,-25387,-24191,-22986,-21801,-20625,-19487,-18372,-17308,-16277,-15283,-14352,-13439,-12570,-11722,-10946,-10169,-9440,-8737,-8034,-7381,-6755,-6154,-5556,-5008,-4439,-3921,-3405,-2915,-2429,-1969,-1511};
@@ -35,6 +38,102 @@ namespace synth {
   const int16_t piano2_waveform [256] = {0,2478,4928,7325,9645,11869,13980,15968,17827,19555,21154,22630,23988,25236,26381,27429,28384,29247,30020,30701,31288,31778,32168,32460,32653,32753,32767,32703,32574,32395,32179,31941,31695,31451,31217,30999,30797,30609,30429,30249,30059,29851,29614,29342,29031,28679,28290,27869,27426,26972,26520,26083,25674,25303,24976,24699,24472,24292,24153,24045,23960,23886,23814,23735,23646,23542,23425,23299,23172,23052,22950,22876,22839,22847,22906,23017,23179,23387,23634,23911,24208,24513,24818,25114,25394,25656,25899,26124,26333,26532,26725,26913,27100,27283,27459,27619,27754,27850,27893,27867,27757,27549,27233,26802,26253,25588,24813,23938,22976,21945,20860,19739,18597,17447,16299,15160,14031,12913,11802,10693,9578,8452,7307,6141,4951,3737,2504,1256,0,-1256,-2504,-3737,-4951,-6141,-7307,-8452,-9578,-10693,-11802,-12913,-14031,-15160,-16299,-17447,-18597,-19739,-20860,-21945,-22976,-23938,-24813,-25588,-26253,-26802,-27233,-27549,-27757,-27867,-27893,-27850,-27754,-27619,-27459,-27283,-27100,-26913,-26725,-26532,-26333,-26124,-25899,-25656,-25394,-25114,-24818,-24513,-24208,-23911,-23634,-23387,-23179,-23017,-22906,-22847,-22839,-22876,-22950,-23052,-23172,-23299,-23425,-23542,-23646,-23735,-23814,-23886,-23960,-24045,-24153,-24292,-24472,-24699,-24976,-25303,-25674,-26083,-26520,-26972,-27426,-27869,-28290,-28679,-29031,-29342,-29614,-29851,-30059,-30249,-30429,-30609,-30797,-30999,-31217,-31451,-31695,-31941,-32179,-32395,-32574,-32703,-32767,-32753,-32653,-32460,-32168,-31778,-31288,-30701,-30020,-29247,-28384,-27429,-26381,-25236,-23988,-22630,-21154,-19555,-17827,-15968,-13980,-11869,-9645,-7325,-4928,-2478};
 
 
+  // percussion one-shots: lengths in frames (kick 150ms, snare 120ms, hat 45ms)
+  const uint16_t drum_length [DRUM_COUNT] = {uint16_t(KICK_FRAMES), uint16_t(SNARE_FRAMES), uint16_t(HAT_FRAMES)};
+  int16_t *drum_oneshot [DRUM_COUNT];
+
+  // white noise sample in the range [-1, 1]; only used when building the one-shots
+  static float noise_sample() {
+    return float(int32_t(prng_xorshift_next())) / 2147483648.0f;
+  }
+
+  // fill the percussion one-shots; this is done once at boot so that
+  // playing a drum costs a table read and no prng at all
+  void init_percussion(int16_t *oneshots) {
+    float phase = 0.0f;
+    float last_noise = 0.0f;
+
+    if(!Engine::supports(Waveform::PERCUSSION)) return;
+    int16_t *kick_oneshot = drum_oneshot[KICK] = oneshots;
+    int16_t *snare_oneshot = drum_oneshot[SNARE] = kick_oneshot + KICK_FRAMES;
+    int16_t *hat_oneshot = drum_oneshot[HAT] = snare_oneshot + SNARE_FRAMES;
+
+    for(uint32_t i = 0; i < drum_length[KICK]; i++) {
+      // sine with a fast pitch drop from 150Hz to 50Hz, and exponential decay
+      float t = float(i) / sample_rate;
+      float frequency = 50.0f + 100.0f * expf(-t / 0.03f);
+      phase += 2.0f * pi * frequency / sample_rate;
+      kick_oneshot[i] = int16_t(32767.0f * sinf(phase) * expf(-t / 0.045f));
+    }
+
+    phase = 0.0f;
+    for(uint32_t i = 0; i < drum_length[SNARE]; i++) {
+      // short 185Hz body plus a longer noise tail
+      float t = float(i) / sample_rate;
+      phase += 2.0f * pi * 185.0f / sample_rate;
+      float body = 0.45f * sinf(phase) * expf(-t / 0.02f);
+      float tail = 0.55f * noise_sample() * expf(-t / 0.035f);
+      snare_oneshot[i] = int16_t(32767.0f * (body + tail));
+    }
+
+    for(uint32_t i = 0; i < drum_length[HAT]; i++) {
+      // first difference of white noise is enough of a high-pass for a hat
+      float t = float(i) / sample_rate;
+      float noise = noise_sample();
+      hat_oneshot[i] = int16_t(16383.0f * (noise - last_noise) * expf(-t / 0.01f));
+      last_noise = noise;
+    }
+
+    // fade out the last frames of each one-shot so that none of them ends with a click
+    for(int d = 0; d < DRUM_COUNT; d++) {
+      for(uint32_t i = 0; i < 64; i++) {
+        int16_t &sample = drum_oneshot[d][drum_length[d] - 64 + i];
+        sample = (int32_t(sample) * int32_t(63 - i)) / 64;
+      }
+    }
+  }
+
+  void AudioChannel::set_pan(int16_t pan) {
+    // constant power pan law, computed once when the voice is set up: the kernels only apply the gains
+    float angle = (float(pan) + 32767.0f) * (pi / 4.0f) / 32767.0f;
+    gain_left = uint16_t(65535.0f * cosf(angle));
+    gain_right = uint16_t(65535.0f * sinf(angle));
+  }
+
+  void AudioChannel::trigger_percussion() {
+    // no frequency means no hit; otherwise the frequency tells which drum to play
+    // (songify.py maps BASS, SNARE and HAT to 500, 6000 and 20000 Hz)
+    if(frequency == 0) {
+      off();
+      return;
+    }
+    Drum drum = (frequency < 1000) ? KICK : ((frequency < 10000) ? SNARE : HAT);
+
+    oneshot = drum_oneshot[drum];
+    oneshot_len = drum_length[drum];
+    oneshot_pos = 0;
+    adsr_frame = 0;
+    adsr_end_frame = oneshot_len;   // not left from the previous note
+    adsr_phase = ADSRPhase::SUSTAIN;
+    adsr_step = 0;
+  }
+
+  // put all voices back in their initial state, and the noise generator to its seed:
+  // from then on, the same notes at the same frames give the same audio
+  void reset_voices() {
+    for(int c = 0; c < CHANNEL_COUNT; c++) {
+      AudioChannel &channel = channels[c];
+      channel.adsr = 0;
+      channel.off();
+      channel.waveform_offset = 0;
+      channel.noise = 0;
+      channel.filter_last_sample = 0;
+      channel.wave_buf_pos = 0;
+      channel.oneshot_pos = 0;
+    }
+    limiter = Limiter();
+    prng_xorshift_state = prng_seed;
+  }
 
   bool is_audio_playing() {
     if(volume == 0) {
@@ -51,223 +150,478 @@ namespace synth {
     return any_channel_playing;
   }
 
-  int16_t get_audio_frame() {
-    int32_t sample = 0;  // used to combine channel output
+  // wavetable of a sampled waveform
+  template <uint32_t W>
+  constexpr const int16_t *wavetable() {
+    switch(W) {
+      case Waveform::SINE:          return sine_waveform;
+      case Waveform::PIANO:         return piano_waveform;
+      case Waveform::PIANO2:        return piano2_waveform;
+      case Waveform::REED:          return reed_waveform;
+      case Waveform::GUITAR:        return guitar_waveform;
+      case Waveform::PLUCKEDGUITAR: return pluckedguitar_waveform;
+      case Waveform::VIOLIN:        return violin_waveform;
+      case Waveform::HORN:          return horn_waveform;
+      case Waveform::OBOE:          return oboe_waveform;
+      case Waveform::CLARINETTE:    return clarinette_waveform;
+      case Waveform::FLUTE:         return flute_waveform;
+      default:                      return nullptr;
+    }
+  }
 
-    for(int c = 0; c < CHANNEL_COUNT; c++) {
+  // value of a single waveform at the given position (Q16) of the waveform
+  template <uint32_t W>
+  inline int32_t oscillator(AudioChannel &channel, uint32_t offset) {
+    if constexpr (W == Waveform::NOISE) {
+      return channel.noise;
+    }
+    else if constexpr (W == Waveform::SAW) {
+      return int32_t(offset) - 0x7fff;
+    }
+    else if constexpr (W == Waveform::TRIANGLE) {
+      // creates a triangle wave of ^
+      if (offset < 0x7fff) { // initial quarter up slope
+        return int32_t(offset * 2) - int32_t(0x7fff);
+      }
+      // final quarter up slope
+      return int32_t(0x7fff) - ((int32_t(offset) - int32_t(0x7fff)) * 2);
+    }
+    else if constexpr (W == Waveform::SQUARE) {
+      return (offset < channel.pulse_width) ? 0x7fff : -0x7fff;
+    }
+    else if constexpr (W == Waveform::TABLE) {
+      return channel.wavetable[offset >> 8];
+    }
+    else if constexpr (W == Waveform::WAVE) {
+      // fix to allow buffer loading at the first call
+      if (channel.wave_buf_pos == 0) {
+        if(channel.wave_buffer_callback)
+          channel.wave_buffer_callback(channel);
+      }
+      int32_t sample = channel.wave_buffer[channel.wave_buf_pos];
+      if (++channel.wave_buf_pos == 64) {
+        channel.wave_buf_pos = 0;
+      }
+      return sample;
+    }
+    else {
+      // the waveform sample contains 256 samples in
+      // total so we'll just use the most significant bits
+      // of the current waveform position to index into it
+      return wavetable<W>()[offset >> 8];
+    }
+  }
+
+  // sum of the waveforms of Mask which are enabled on the channel; bits are tested
+  // at run time, but waveforms outside of Mask are not even compiled
+  template <uint32_t Mask, int Bit = 17>
+  inline int32_t oscillators(AudioChannel &channel, uint32_t offset) {
+    if constexpr (Bit < 0) {
+      return 0;
+    }
+    else {
+      int32_t sample = oscillators<Mask, Bit - 1>(channel, offset);
+      if constexpr ((Mask & (1u << Bit)) != 0) {
+        if(channel.waveforms & (1u << Bit)) sample += oscillator<1u << Bit>(channel, offset);
+      }
+      return sample;
+    }
+  }
+
+  bool mix_wavetable(uint32_t waveforms, int16_t *table) {
+    if((waveforms == 0) || ((waveforms & ~TABLE_WAVEFORMS) != 0)) return false;
+
+    // same oscillators and averaging as the kernels, at the position of each sample of the table
+    AudioChannel channel;
+    channel.waveforms = waveforms;
+    int32_t scale = 0x10000 / __builtin_popcount(waveforms);
+    for(uint32_t i = 0; i < WAVETABLE_SIZE; i++) {
+      table[i] = int16_t((oscillators<TABLE_WAVEFORMS>(channel, i << 8) * scale) >> 16);
+    }
+    return true;
+  }
+
+  int16_t lowpass_coefficient(uint32_t cutoff) {
+    if(cutoff == 0) return 0;
+    // y += (x - y) * (1 - e^(-2.pi.fc/fs)); at least 1 so that the filter stays on
+    float coefficient = 32767.0f * (1.0f - expf(-2.0f * pi * float(cutoff) / float(sample_rate)));
+    return (coefficient < 1.0f) ? 1 : int16_t(coefficient);
+  }
+
+  uint32_t lfo_increment(uint32_t rate) {
+    return uint32_t((uint64_t(rate) << 32) / (10 * sample_rate));
+  }
+
+  uint32_t vibrato_ratio(uint32_t cents) {
+    return uint32_t(65536.0f * (exp2f(float(cents) / 1200.0f) - 1.0f));
+  }
+
+  // gain of the tremolo at an lfo phase (Q16): full gain at the top of the lfo, less depth at its bottom
+  static inline uint32_t tremolo_gain(const AudioChannel &channel, uint32_t phase) {
+    return 0x10000 - ((uint32_t(channel.tremolo_depth) * uint32_t(sine_waveform[phase >> 24] + 0x8000)) >> 16);
+  }
+
+  // ramp of the envelope scaled by a gain (Q24 envelope, Q16 gains) over n frames, the gain going from gain to gain_end:
+  // the product of the two ramps is taken as a ramp, which is close enough over a block.
+  // The step is rounded toward 0 and the ramp stops at 0: below 0, at the end of a release, it would wrap around to full scale
+  static inline void gain_ramp(uint32_t adsr, int32_t adsr_step, uint32_t gain, uint32_t gain_end, uint32_t n,
+                               uint32_t &ramp, int32_t &ramp_step) {
+    ramp = (uint64_t(adsr) * gain) >> 16;
+    if(gain == gain_end) {
+      ramp_step = int32_t((int64_t(adsr_step) * gain) / 0x10000);
+    }
+    else {
+      uint32_t end = (uint64_t(adsr + (adsr_step * int32_t(n))) * gain_end) >> 16;
+      ramp_step = (int32_t(end) - int32_t(ramp)) / int32_t(n);
+    }
+    // steps are below 2^24 and n at most SYNTH_BLOCK: no overflow
+    if((ramp_step < 0) && (uint32_t(-ramp_step) * n > ramp)) ramp_step = -int32_t(ramp / n);
+  }
+
+  // move the channel envelope to its next phase
+  inline void next_adsr_phase(AudioChannel &channel) {
+    switch (channel.adsr_phase) {
+      case ADSRPhase::ATTACK:
+        channel.trigger_decay();
+        break;
+      case ADSRPhase::DECAY:
+        channel.trigger_sustain();
+        break;
+      case ADSRPhase::SUSTAIN:
+        channel.trigger_release();
+        break;
+      case ADSRPhase::RELEASE:
+        channel.off();
+        break;
+      default:
+        break;
+    }
+  }
+
+  // channel volume combined with the master volume, once per block:
+  // the mix then only needs to be clipped
+  static inline int32_t voice_volume(const AudioChannel &channel) {
+    return (uint32_t(channel.volume) * volume) >> 16;
+  }
+
+  // voice kernel: render count frames of a channel and add them to mix, and to the send mix if the channel has a send level
+  //
+  // Mask is the set of waveforms the kernel is compiled for. When Mask is a single
+  // waveform, the kernel is specialised for that waveform only (no bit test, no mixing);
+  // otherwise the kernel handles any combination of the waveforms of Mask.
+  // The loop is split at envelope phase changes, so that the inner loop has no test at all.
+  //
+  // Modulation costs nothing per sample: the lfos are evaluated once per block. The vibrato sets the phase
+  // increment of the block (its pitch moves by far less than a cent from a block to the next), the tremolo
+  // gain is folded into the envelope ramps, and the filter follows the envelope at each block and envelope phase change.
+  template <uint32_t Mask>
+  void render_voice(AudioChannel &channel, int32_t *mix, int32_t *send, uint32_t count) {
+    constexpr bool single = (Mask & (Mask - 1)) == 0;
+
+    // phase increment of the waveform position counter. this provides an
+    // Q16 fixed point value representing how far through
+    // the current waveform we are; its fraction (Q8 of the increment unit) is summed
+    // over the block, and carried to the position once per block
+    uint32_t increment = (uint32_t(channel.frequency) << 16) / sample_rate;
+    uint32_t fraction = ((((uint32_t(channel.frequency) << 16) % sample_rate) << 8) / sample_rate);
+    if(channel.vibrato_depth) {
+      int32_t deviation = (int32_t(channel.vibrato_depth) * sine_waveform[channel.vibrato_phase >> 24]) >> 15;
+      uint32_t exact = (increment << 8) | fraction;
+      exact += int32_t((int64_t(exact) * deviation) >> 16);
+      increment = exact >> 8;
+      fraction = exact & 0xff;
+      channel.vibrato_phase += channel.vibrato_rate * count;
+    }
+    channel.phase_fraction += fraction * count;
+    channel.waveform_offset = (channel.waveform_offset + (channel.phase_fraction >> 8)) & 0xffff;
+    channel.phase_fraction &= 0xff;
+
+    // tremolo gain, from the end of the last block to the end of this one
+    uint32_t gain = channel.tremolo_depth ? channel.tremolo_gain : 0x10000;
+    int32_t gain_step = 0;
+    if(channel.tremolo_depth) {
+      channel.tremolo_phase += channel.tremolo_rate * count;
+      channel.tremolo_gain = tremolo_gain(channel, channel.tremolo_phase);
+      gain_step = (int32_t(channel.tremolo_gain) - int32_t(gain)) / int32_t(count);
+    }
 
-      auto &channel = channels[c];
+    // mixed waveforms are averaged; division is done with a Q16 reciprocal
+    int32_t waveform_count = single ? 1 : __builtin_popcount(channel.waveforms & Mask);
+    int32_t scale = single ? 0x10000 : (waveform_count ? 0x10000 / waveform_count : 0);
 
-      // increment the waveform position counter. this provides an
-      // Q16 fixed point value representing how far through
-      // the current waveform we are
-      channel.waveform_offset += ((channel.frequency * 256) << 8) / sample_rate;
+    // channel frequency is 0 or no waveform: no sample, but the envelope goes on
+    bool silent = (channel.frequency == 0) || (waveform_count == 0);
 
+    // low-pass filter, if the instrument has one
+    int32_t filtered = channel.filter_last_sample;
+
+    uint32_t done = 0;
+    while(done < count) {
       if(channel.adsr_phase == ADSRPhase::OFF) {
-        continue;
+        // keep the waveform position running while the channel is off
+        channel.waveform_offset = (channel.waveform_offset + increment * (count - done)) & 0xffff;
+        return;
       }
 
-//      if ((channel.adsr_frame >= channel.adsr_end_frame) && (channel.adsr_phase != ADSRPhase::SUSTAIN)) {
-      if (channel.adsr_frame >= channel.adsr_end_frame) {
-        switch (channel.adsr_phase) {
-          case ADSRPhase::ATTACK:
-            channel.trigger_decay();
-            break;
-          case ADSRPhase::DECAY:
-            channel.trigger_sustain();
-            break;
-          case ADSRPhase::SUSTAIN:
-            channel.trigger_release();
-            break;
-          case ADSRPhase::RELEASE:
-            channel.off();
-            break;
-          default:
-            break;
-        }
+      if(channel.adsr_frame >= channel.adsr_end_frame) {
+        next_adsr_phase(channel);
+        if(channel.adsr_phase == ADSRPhase::OFF) continue;
       }
 
-      channel.adsr += channel.adsr_step;
-      channel.adsr_frame++;
+      // number of frames until the next envelope phase change (at least one)
+      uint32_t n = count - done;
+      uint32_t left = (channel.adsr_end_frame > channel.adsr_frame) ? channel.adsr_end_frame - channel.adsr_frame : 1;
+      if(n > left) n = left;
+
+      uint32_t offset = channel.waveform_offset;
+      uint32_t adsr = channel.adsr;
+      int32_t adsr_step = channel.adsr_step;
+      int32_t volume = voice_volume(channel);
+      int32_t *out = mix + (done * output_channels);
+
+      // filter coefficient raised by the envelope, at the start of the envelope phase or block
+      int32_t filter = channel.filter;
+      if(filter && channel.filter_env) filter += (int32_t(channel.filter_env) * int32_t(adsr >> 9)) >> 15;
+
+      // the envelope is a linear ramp, so are the envelope scaled by the volume (and tremolo gain)
+      // and pan gain of each side. Each side is then a ramp (Q24) of its own, and panning costs no more multiplies than mono
+      uint32_t gain_start = gain + (gain_step * int32_t(done));
+      uint32_t gain_end = gain_start + (gain_step * int32_t(n));
+      uint32_t volume_left = (output_channels == 2) ? (uint32_t(volume) * channel.gain_left) >> 16 : uint32_t(volume);
+      uint32_t ramp_left, ramp_right = 0;
+      int32_t ramp_left_step, ramp_right_step = 0;
+      gain_ramp(adsr, adsr_step, (volume_left * gain_start) >> 16, (volume_left * gain_end) >> 16, n, ramp_left, ramp_left_step);
+      if constexpr (output_channels == 2) {
+        uint32_t volume_right = (uint32_t(volume) * channel.gain_right) >> 16;
+        gain_ramp(adsr, adsr_step, (volume_right * gain_start) >> 16, (volume_right * gain_end) >> 16, n, ramp_right, ramp_right_step);
+      }
 
-      if(channel.waveform_offset & 0x10000) {
-        // if the waveform offset overflows then generate a new
-        // random noise sample
-        channel.noise = prng_normal();
+      // send to the effect bus: a mono ramp of its own, the same way
+      int32_t *to_send = send + done;
+      uint32_t volume_send = (uint32_t(volume) * channel.send) >> 16;
+      uint32_t ramp_send = 0;
+      int32_t ramp_send_step = 0;
+      if(volume_send) {
+        gain_ramp(adsr, adsr_step, (volume_send * gain_start) >> 16, (volume_send * gain_end) >> 16, n, ramp_send, ramp_send_step);
       }
 
-      channel.waveform_offset &= 0xffff;
+      for(uint32_t i = 0; i < n; i++) {
+        adsr += adsr_step;
+        offset += increment;
 
-      // check if any waveforms are active for this channel
-      if(channel.waveforms) {
-        uint8_t waveform_count = 0;
-        int32_t channel_sample = 0;
+        if constexpr ((Mask & Waveform::NOISE) != 0) {
+          if(offset & 0x10000) {
+            // if the waveform offset overflows then generate a new
+            // random noise sample
+            channel.noise = prng_normal();
+          }
+        }
+        offset &= 0xffff;
 
-        // check if channel frequency is 0; if so, then sample shall be 0
-        if (channel.frequency == 0) channel_sample +=0;
-        // if channel frequency is not 0, then process sample
+        if(silent) continue;
+
+        int32_t channel_sample;
+        if constexpr (single) {
+          channel_sample = oscillator<Mask>(channel, offset);
+        }
         else {
+          channel_sample = (oscillators<Mask>(channel, offset) * scale) >> 16;
+        }
+        if(filter) {
+          // difference is at most 16 bits, coefficient 15 bits: fits in 32 bits
+          filtered += ((channel_sample - filtered) * filter) >> 15;
+          channel_sample = filtered;
+        }
+        if(volume_send) {
+          ramp_send += ramp_send_step;
+          to_send[i] += (channel_sample * int32_t(ramp_send >> 8)) >> 16;
+        }
 
-          if(channel.waveforms & Waveform::NOISE) {
-            channel_sample += channel.noise;
-            waveform_count++;
-          }
+        // apply envelope and channel volume, and combine channel sample into the final sample
+        ramp_left += ramp_left_step;
+        if constexpr (output_channels == 2) {
+          ramp_right += ramp_right_step;
+          out[2 * i] += (channel_sample * int32_t(ramp_left >> 8)) >> 16;
+          out[2 * i + 1] += (channel_sample * int32_t(ramp_right >> 8)) >> 16;
+        }
+        else {
+          out[i] += (channel_sample * int32_t(ramp_left >> 8)) >> 16;
+        }
+      }
 
-          if(channel.waveforms & Waveform::SAW) {
-            channel_sample += (int32_t)channel.waveform_offset - 0x7fff;
-            waveform_count++;
-          }
+      channel.waveform_offset = offset;
+      channel.filter_last_sample = filtered;
+      channel.adsr = adsr;
+      channel.adsr_frame += n;
+      done += n;
+    }
+  }
 
-          // creates a triangle wave of ^
-          if (channel.waveforms & Waveform::TRIANGLE) {
-            if (channel.waveform_offset < 0x7fff) { // initial quarter up slope
-              channel_sample += int32_t(channel.waveform_offset * 2) - int32_t(0x7fff);
-            }
-            else { // final quarter up slope
-              channel_sample += int32_t(0x7fff) - ((int32_t(channel.waveform_offset) - int32_t(0x7fff)) * 2);
-            }
-            waveform_count++;
-          }
+  // percussion kernel: channels just read through their one-shot, no oscillator, no envelope
+  void render_percussion(AudioChannel &channel, int32_t *mix, int32_t *send, uint32_t count) {
+    if(channel.adsr_phase == ADSRPhase::OFF) return;
 
-          if (channel.waveforms & Waveform::SQUARE) {
-            channel_sample += (channel.waveform_offset < channel.pulse_width) ? 0x7fff : -0x7fff;
-            waveform_count++;
-          }
+    uint32_t n = channel.oneshot_len - channel.oneshot_pos;
+    if(n > count) n = count;
 
-          if(channel.waveforms & Waveform::SINE) {
-            // the sine_waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += sine_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+    const int16_t *oneshot = channel.oneshot + channel.oneshot_pos;
+    int32_t volume = voice_volume(channel);
+    int32_t volume_send = (uint32_t(volume) * channel.send) >> 16;
+    if(volume_send) {
+      for(uint32_t i = 0; i < n; i++) {
+        send[i] += (int32_t(oneshot[i]) * volume_send) >> 16;
+      }
+    }
+    if constexpr (output_channels == 2) {
+      int32_t volume_left = (uint32_t(volume) * channel.gain_left) >> 16;
+      int32_t volume_right = (uint32_t(volume) * channel.gain_right) >> 16;
+      for(uint32_t i = 0; i < n; i++) {
+        mix[2 * i] += (int32_t(oneshot[i]) * volume_left) >> 16;
+        mix[2 * i + 1] += (int32_t(oneshot[i]) * volume_right) >> 16;
+      }
+    }
+    else {
+      for(uint32_t i = 0; i < n; i++) {
+        mix[i] += (int32_t(oneshot[i]) * volume) >> 16;
+      }
+    }
 
-          if(channel.waveforms & Waveform::PIANO) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += piano_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+    channel.oneshot_pos += n;
+    if(channel.oneshot_pos >= channel.oneshot_len) channel.off();
+  }
 
-          if(channel.waveforms & Waveform::PIANO2) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += piano2_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+  // pick the fastest kernel for a channel: a kernel specialised for its waveform if it
+  // uses a single waveform of Mask, the generic kernel for Mask otherwise
+  template <uint32_t Mask, int Bit = 17>
+  voice_kernel select_kernel(uint32_t waveforms) {
+    if constexpr (Bit < 0) {
+      return &render_voice<Mask & ~uint32_t(Waveform::PERCUSSION)>;
+    }
+    else {
+      constexpr uint32_t w = 1u << Bit;
+      if constexpr ((Mask & w) != 0) {
+        if constexpr (w == Waveform::PERCUSSION) {
+          if(waveforms & w) return &render_percussion;
+        }
+        else {
+          if(waveforms == w) return &render_voice<w>;
+        }
+      }
+      return select_kernel<Mask, Bit - 1>(waveforms);
+    }
+  }
 
-          if(channel.waveforms & Waveform::REED) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += reed_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+  // gain bringing a peak of the mix under full scale: unity up to the knee, then the output level
+  // bends smoothly from the knee towards full scale as the peak goes up
+  static inline uint32_t limiter_gain(uint32_t peak) {
+    constexpr uint32_t room = 0x7fff - LIMITER_KNEE;
+    if(peak <= LIMITER_KNEE) return LIMITER_UNITY;
+    uint32_t over = peak - LIMITER_KNEE;
+    uint32_t level = LIMITER_KNEE + uint32_t((uint64_t(over) * room) / (over + room));
+    return (level << 16) / peak;
+  }
 
-          if(channel.waveforms & Waveform::GUITAR) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += guitar_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+  static inline int16_t clip(int32_t sample) {
+    return sample <= -0x8000 ? -0x8000 : (sample > 0x7fff ? 0x7fff : sample);
+  }
 
-          if(channel.waveforms & Waveform::PLUCKEDGUITAR) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += pluckedguitar_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+  // output n frames of the mix: the delayed frames first, then the new block, whose peaks are already known
+  static void limit(Limiter &limiter, const int32_t *mix, int16_t *out, uint32_t n) {
+    constexpr uint32_t release = LIMITER_UNITY / ((LIMITER_RELEASE_MS * sample_rate) / 1000);
+    constexpr uint32_t lookahead = LIMITER_LOOKAHEAD * output_channels;
+    uint32_t peaks[(SYNTH_BLOCK + (2 * LIMITER_LOOKAHEAD) - 1) / LIMITER_LOOKAHEAD];
+
+    // peak of each LIMITER_LOOKAHEAD frames of the mix; the peak of the delayed frames is known from the previous block
+    uint32_t total = (n * output_channels) + lookahead;
+    peaks[0] = limiter.delay_peak;
+    for(uint32_t i = lookahead, k = 1; i < total; k++) {
+      uint32_t end = (i + lookahead < total) ? i + lookahead : total;
+      uint32_t peak = 0;
+      for(; i < end; i++) {
+        uint32_t level = (mix[i] < 0) ? -mix[i] : mix[i];
+        if(level > peak) peak = level;
+      }
+      peaks[k] = peak;
+    }
 
-          if(channel.waveforms & Waveform::VIOLIN) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += violin_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+    // gain is ramped over sub-blocks of at most LIMITER_LOOKAHEAD frames, towards the gain of the peak of the
+    // sub-block and of the lookahead after it: the previous sub-block has thus already brought the gain under
+    // the gain of this one, and the whole ramp is under the gain of every sample it is applied to
+    for(uint32_t start = 0, k = 0; start < n; start += LIMITER_LOOKAHEAD, k++) {
+      uint32_t m = (n - start < LIMITER_LOOKAHEAD) ? n - start : LIMITER_LOOKAHEAD;
+      const int32_t *in = &mix[start * output_channels];
+      int16_t *to = &out[start * output_channels];
 
-          if(channel.waveforms & Waveform::HORN) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += horn_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+      uint32_t target = limiter_gain((peaks[k] > peaks[k + 1]) ? peaks[k] : peaks[k + 1]);
+      if(target > limiter.gain + (release * m)) target = limiter.gain + (release * m);
 
-          if(channel.waveforms & Waveform::OBOE) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += oboe_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+      // nothing to limit: the mix is only clipped, as a safety
+      if((target == LIMITER_UNITY) && (limiter.gain == LIMITER_UNITY)) {
+        for(uint32_t i = 0; i < m * output_channels; i++) to[i] = clip(in[i]);
+        continue;
+      }
 
-          if(channel.waveforms & Waveform::CLARINETTE) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += clarinette_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+      int32_t gain = int32_t(limiter.gain);
+      int32_t step = (int32_t(target) - gain) / int32_t(m);
+      for(uint32_t i = 0; i < m; i++) {
+        gain += step;
+        for(uint32_t s = i * output_channels; s < (i + 1) * output_channels; s++) {
+          // the mix is kept within 20 bits so that it can be scaled by a 12-bit gain
+          int32_t sample = (in[s] > 0x7ffff) ? 0x7ffff : ((in[s] < -0x7ffff) ? -0x7ffff : in[s]);
+          to[s] = clip((sample * (gain >> 4)) >> 12);
+        }
+      }
+      limiter.gain = target;
+    }
 
-          if(channel.waveforms & Waveform::FLUTE) {
-            // the waveform sample contains 256 samples in
-            // total so we'll just use the most significant bits
-            // of the current waveform position to index into it
-            channel_sample += flute_waveform[channel.waveform_offset >> 8];
-            waveform_count++;
-          }
+    // peak of the frames delayed to the next block: the last peak if the block is made of whole sub-blocks
+    if(n % LIMITER_LOOKAHEAD == 0) {
+      limiter.delay_peak = peaks[n / LIMITER_LOOKAHEAD];
+    }
+    else {
+      limiter.delay_peak = 0;
+      for(uint32_t i = n * output_channels; i < total; i++) {
+        uint32_t level = (mix[i] < 0) ? -mix[i] : mix[i];
+        if(level > limiter.delay_peak) limiter.delay_peak = level;
+      }
+    }
+  }
 
-          if(channel.waveforms & Waveform::WAVE) {
-
-            // fix to allow buffer loading at the first call
-            if (channel.wave_buf_pos == 0) {
-              if(channel.wave_buffer_callback)
-                  channel.wave_buffer_callback(channel);
-            }
-            channel_sample += channel.wave_buffer[channel.wave_buf_pos];
-            if (++channel.wave_buf_pos == 64) {
-              channel.wave_buf_pos = 0;
-            }
-
-//          channel_sample += channel.wave_buffer[channel.wave_buf_pos];
-//          if (++channel.wave_buf_pos == 64) {
-//            channel.wave_buf_pos = 0;
-//            if(channel.wave_buffer_callback)
-//                channel.wave_buffer_callback(channel);
-//          }
-            waveform_count++;
-          }
-        }
+  template <int Voices, uint32_t WaveformMask>
+  void Synth<Voices, WaveformMask>::render(AudioChannel *voices, Limiter &limiter, int16_t *out, int16_t *send, uint32_t count) {
+    constexpr uint32_t delayed = LIMITER_LOOKAHEAD * output_channels;
+    int32_t mix[(LIMITER_LOOKAHEAD + SYNTH_BLOCK) * output_channels];   // delayed frames, then channel output combined
+    int32_t sends[SYNTH_BLOCK];                                         // send mix of the channels
 
-        channel_sample = channel_sample / waveform_count;
+    while(count) {
+      uint32_t n = (count < SYNTH_BLOCK) ? count : SYNTH_BLOCK;
 
-        channel_sample = (int64_t(channel_sample) * int32_t(channel.adsr >> 8)) >> 16;
+      for(uint32_t i = 0; i < delayed; i++) mix[i] = limiter.delay[i];
+      for(uint32_t i = delayed; i < delayed + (n * output_channels); i++) mix[i] = 0;
+      for(uint32_t i = 0; i < n; i++) sends[i] = 0;
 
-        // apply channel volume
-        channel_sample = (int64_t(channel_sample) * int32_t(channel.volume)) >> 16;
+      for(int c = 0; c < Voices; c++) {
+        auto &channel = voices[c];
+        select_kernel<WaveformMask>(channel.waveforms)(channel, &mix[delayed], sends, n);
+      }
 
-        // apply channel filter
-        //if (channel.filter_enable) {
-          //float filter_epow = 1 - expf(-(1.0f / 22050.0f) * 2.0f * pi * int32_t(channel.filter_cutoff_frequency));
-          //channel_sample += (channel_sample - channel.filter_last_sample) * filter_epow;
-        //}
+      // the send mix is not delayed nor limited: the effect bus has a latency of its own, and its return is low
+      for(uint32_t i = 0; i < n; i++) send[i] = clip(sends[i]);
 
-        //channel.filter_last_sample = channel_sample;
+      // master volume is already applied by the kernels: limit the result to 16-bit
+      limit(limiter, mix, out, n);
+      for(uint32_t i = 0; i < delayed; i++) limiter.delay[i] = mix[(n * output_channels) + i];
 
-        // combine channel sample into the final sample
-        sample += channel_sample;
-      }
+      out += n * output_channels;
+      send += n;
+      count -= n;
     }
+  }
 
-    sample = (int64_t(sample) * int32_t(volume)) >> 16;
+  // the engine of this build
+  template struct Synth<SYNTH_VOICES, SYNTH_WAVEFORMS>;
 
-    // clip result to 16-bit
-    sample = sample <= -0x8000 ? -0x8000 : (sample > 0x7fff ? 0x7fff : sample);
-    return sample;
+  void render(int16_t *out, int16_t *send, uint32_t count) {
+    Engine::render(channels, limiter, out, send, count);
   }
-}
\ No newline at end of file
+}
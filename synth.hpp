@@ -39,11 +39,32 @@ namespace synth {
   // |X   |    |    |    |    |    |    |    |    |    |    |    |    |    |    |    |    |
   // +----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+--->
 
-  #define CHANNEL_COUNT 9
+  // number of voices of the engine; can be set at build time
+  #ifndef SYNTH_VOICES
+  #define SYNTH_VOICES 9
+  #endif
+  #define CHANNEL_COUNT SYNTH_VOICES
+
+  // the engine renders audio by blocks of at most SYNTH_BLOCK frames
+  #define SYNTH_BLOCK 64
+
+  // stereo output: frames are interleaved left / right samples, and each voice is panned; can be set at build time
+  #ifndef SYNTH_STEREO
+  #define SYNTH_STEREO 0
+  #endif
+  constexpr uint32_t output_channels = SYNTH_STEREO ? 2 : 1;
 
   constexpr float pi = 3.14159265358979323846f;
 
-  const uint32_t sample_rate = 44100;
+  // sample rate of the engine (Hz); can be set at build time. Phase increments, envelope lengths
+  // and percussion one-shots are all derived from it, and the i2s clock is set up from it
+  #ifndef SYNTH_SAMPLE_RATE
+  #define SYNTH_SAMPLE_RATE 44100
+  #endif
+  constexpr uint32_t sample_rate = SYNTH_SAMPLE_RATE;
+  static_assert((sample_rate == 22050) || (sample_rate == 32000) || (sample_rate == 44100) || (sample_rate == 48000),
+                "sample rate must be 22050, 32000, 44100 or 48000");
+
   extern uint16_t volume;
 
   enum Waveform {
@@ -62,9 +83,80 @@ namespace synth {
     SAW       = 32,
     TRIANGLE  = 16,
     SINE      = 8,
+    TABLE     = 4,
+    PERCUSSION= 2,
     WAVE      = 1
   };
 
+  constexpr uint32_t ALL_WAVEFORMS = FLUTE | CLARINETTE | OBOE | HORN | VIOLIN | PLUCKEDGUITAR | GUITAR | REED | PIANO2 | PIANO |
+                                     NOISE | SQUARE | SAW | TRIANGLE | SINE | TABLE | PERCUSSION | WAVE;
+
+  // waveforms which can be mixed once into a wavetable (see mix_wavetable), and then played as a TABLE
+  constexpr uint32_t TABLE_WAVEFORMS = ALL_WAVEFORMS & ~uint32_t(NOISE | TABLE | PERCUSSION | WAVE);
+  #define WAVETABLE_SIZE 256
+
+  // waveforms compiled in the engine; can be set at build time (eg. PIANO|GUITAR|PERCUSSION)
+  // to keep only the instruments a firmware needs
+  #ifndef SYNTH_WAVEFORMS
+  #define SYNTH_WAVEFORMS ALL_WAVEFORMS
+  #endif
+
+  // percussion one-shots, precomputed at boot by init_percussion();
+  // on a PERCUSSION channel the note frequency selects the drum that is played
+  enum Drum : uint8_t {
+    KICK,
+    SNARE,
+    HAT,
+    DRUM_COUNT
+  };
+
+  // length of the one-shots, in frames
+  constexpr uint32_t drum_frames(uint32_t ms) {
+    return (ms * sample_rate) / 1000;
+  }
+  constexpr uint32_t KICK_FRAMES = drum_frames(150);
+  constexpr uint32_t SNARE_FRAMES = drum_frames(120);
+  constexpr uint32_t HAT_FRAMES = drum_frames(45);
+  constexpr uint32_t PERCUSSION_FRAMES = KICK_FRAMES + SNARE_FRAMES + HAT_FRAMES;
+
+  // number of frames of an envelope phase of ms milliseconds (at least one frame)
+  constexpr uint32_t envelope_frames(uint32_t ms) {
+    return ((ms * sample_rate) / 1000) ? (ms * sample_rate) / 1000 : 1;
+  }
+
+  // instrument, as set on a channel; it is derived once from the instrument settings (see presets),
+  // so that setting up a channel or triggering a note needs no computation
+  struct Instrument {
+    uint32_t  waveforms     = 0;      // waveforms; TABLE if they have been mixed into wavetable
+    const int16_t *wavetable = nullptr; // mixed waveforms (TABLE only)
+    uint32_t  attack_frames = 1;      // envelope phases, in frames
+    uint32_t  decay_frames  = 1;
+    uint32_t  sustain_frames = 1;
+    uint32_t  release_frames = 1;
+    uint16_t  sustain       = 0xffff; // sustain volume
+    uint16_t  volume        = 0xffff; // channel volume
+    int16_t   filter        = 0;      // one-pole low-pass coefficient (Q15); 0 if no filter
+    uint16_t  send          = 0;      // send level to the effect bus
+    uint32_t  vibrato_rate  = 0;      // lfo phase increments per frame (Q32); see AudioChannel
+    uint32_t  vibrato_depth = 0;
+    uint32_t  tremolo_rate  = 0;
+    uint16_t  tremolo_depth = 0;
+    int16_t   filter_env    = 0;
+  };
+
+  // mix waveforms into a wavetable of WAVETABLE_SIZE samples, as the engine would mix them;
+  // returns false if they cannot be mixed (see TABLE_WAVEFORMS)
+  bool mix_wavetable(uint32_t waveforms, int16_t *table);
+
+  // coefficient of the one-pole low-pass filter for a cutoff frequency; 0 (no filter) if cutoff is 0
+  int16_t lowpass_coefficient(uint32_t cutoff);
+
+  // phase increment per frame of an lfo (Q32), for a rate in tenths of Hz
+  uint32_t lfo_increment(uint32_t rate);
+
+  // pitch deviation of a vibrato of some cents, as a frequency ratio less 1 (Q16)
+  uint32_t vibrato_ratio(uint32_t cents);
+
   enum class ADSRPhase : uint8_t {
     ATTACK,
     DECAY,
@@ -77,20 +169,35 @@ namespace synth {
     uint32_t  waveforms    = 0;      // bitmask for enabled waveforms (see AudioWaveform enum for values)
     uint16_t  frequency     = 660;    // frequency of the voice (Hz)
     uint16_t  volume        = 0xffff; // channel volume (default 100%)
+    uint16_t  send          = 0;      // send level to the effect bus, relative to the channel volume (default none)
+    uint16_t  gain_left     = 0xb504; // pan gains of the channel, set by set_pan() (stereo output only; default centre)
+    uint16_t  gain_right    = 0xb504;
 
-    uint16_t  attack_ms     = 2;      // attack period
-    uint16_t  decay_ms      = 6;      // decay period
+    uint32_t  attack_frames = envelope_frames(2);   // attack period
+    uint32_t  decay_frames  = envelope_frames(6);   // decay period
     uint16_t  sustain       = 0xffff; // sustain volume
-    uint16_t  sustain_ms    = 10;     // sustain period
-    uint16_t  release_ms    = 1;      // release period
+    uint32_t  sustain_frames = envelope_frames(10); // sustain period
+    uint32_t  release_frames = envelope_frames(1);  // release period
     uint16_t  pulse_width   = 0x7fff; // duty cycle of square wave (default 50%)
     int16_t   noise         = 0;      // current noise value
 
     uint32_t  waveform_offset  = 0;   // voice offset (Q8)
+    uint32_t  phase_fraction = 0;     // fraction of the voice offset, carried from a block to the next (Q8 of its unit)
 
+    const int16_t *wavetable = nullptr; // mixed waveforms of a TABLE channel
+    int16_t   filter        = 0;      // one-pole low-pass coefficient (Q15); 0 if no filter
     int32_t   filter_last_sample = 0;
-    bool      filter_enable = false;
-    uint16_t  filter_cutoff_frequency = 0;
+
+    // modulation, evaluated once per block (see render_voice): the vibrato lfo sets the phase increment of the block,
+    // the tremolo lfo ramps the gain over the block, and the envelope raises the filter coefficient
+    uint32_t  vibrato_rate  = 0;      // vibrato lfo phase increment per frame (Q32)
+    uint32_t  vibrato_depth = 0;      // pitch deviation at the top of the vibrato (Q16 frequency ratio); 0 if no vibrato
+    uint32_t  vibrato_phase = 0;
+    uint32_t  tremolo_rate  = 0;      // tremolo lfo phase increment per frame (Q32)
+    uint16_t  tremolo_depth = 0;      // gain taken off at the bottom of the tremolo (Q16); 0 if no tremolo
+    uint32_t  tremolo_phase = 0;
+    uint32_t  tremolo_gain  = 0x10000; // tremolo gain at the end of the last block (Q16)
+    int16_t   filter_env    = 0;      // filter coefficient added at the top of the envelope (Q15)
 
     uint32_t  adsr_frame    = 0;      // number of frames into the current ADSR phase
     uint32_t  adsr_end_frame = 0;     // frame target at which the ADSR changes to the next phase
@@ -99,33 +206,68 @@ namespace synth {
     ADSRPhase adsr_phase    = ADSRPhase::OFF;
 
     uint8_t   wave_buf_pos  = 0;      //
-    int16_t   wave_buffer[64];        // buffer for arbitrary waveforms. small as it's filled by user callback
+    int16_t   *wave_buffer  = nullptr; // buffer of 64 samples for arbitrary waveforms, filled by the user callback; set along with it
 
     void *user_data = nullptr;
     void (*wave_buffer_callback)(AudioChannel &channel);
 
+    const int16_t *oneshot  = nullptr; // percussion one-shot being played (PERCUSSION channels only)
+    uint16_t  oneshot_pos   = 0;      // current position in the one-shot
+    uint16_t  oneshot_len   = 0;      // length of the one-shot, in frames
+
+    void trigger_percussion();
+    void set_pan(int16_t pan);        // -0x7fff (left) to 0x7fff (right)
+
+    void set_instrument(const Instrument &instrument) {
+      waveforms = instrument.waveforms;
+      wavetable = instrument.wavetable;
+      attack_frames = instrument.attack_frames;
+      decay_frames = instrument.decay_frames;
+      sustain = instrument.sustain;
+      sustain_frames = instrument.sustain_frames;
+      release_frames = instrument.release_frames;
+      volume = instrument.volume;
+      filter = instrument.filter;
+      send = instrument.send;
+      vibrato_rate = instrument.vibrato_rate;
+      vibrato_depth = instrument.vibrato_depth;
+      tremolo_rate = instrument.tremolo_rate;
+      tremolo_depth = instrument.tremolo_depth;
+      filter_env = instrument.filter_env;
+    }
+
     void trigger_attack()  {
+      if(waveforms & Waveform::PERCUSSION) {
+        trigger_percussion();
+        return;
+      }
+      // lfos start with the note: vibrato from the pitch of the note, tremolo from full gain
+      vibrato_phase = 0x40000000;
+      tremolo_phase = 0;
+      tremolo_gain = 0x10000;
       adsr_frame = 0;
       adsr_phase = ADSRPhase::ATTACK;
-      adsr_end_frame = (attack_ms * sample_rate) / 1000;
+      adsr_end_frame = attack_frames;
       adsr_step = (int32_t(0xffffff) - int32_t(adsr)) / int32_t(adsr_end_frame);
     }
     void trigger_decay() {
       adsr_frame = 0;
       adsr_phase = ADSRPhase::DECAY;
-      adsr_end_frame = (decay_ms * sample_rate) / 1000;
+      adsr_end_frame = decay_frames;
       adsr_step = (int32_t(sustain << 8) - int32_t(adsr)) / int32_t(adsr_end_frame);
     }
     void trigger_sustain() {
       adsr_frame = 0;
       adsr_phase = ADSRPhase::SUSTAIN;
-      adsr_end_frame = (sustain_ms * sample_rate) / 1000;;
+      adsr_end_frame = sustain_frames;
       adsr_step = 0;
     }
     void trigger_release() {
+      // one-shots always play to their end, whatever happens to the pedal
+      if(waveforms & Waveform::PERCUSSION) return;
       adsr_frame = 0;
       adsr_phase = ADSRPhase::RELEASE;
-      adsr_end_frame = (release_ms * sample_rate) / 1000;
+      adsr_end_frame = release_frames;
       adsr_step = (int32_t(0) - int32_t(adsr)) / int32_t(adsr_end_frame);
     }
     void off() {
@@ -137,7 +279,51 @@ namespace synth {
 
   extern AudioChannel channels[CHANNEL_COUNT];
 
-  int16_t get_audio_frame();
+  // master limiter: the mix is delayed by LIMITER_LOOKAHEAD frames, so that the gain is already down when a peak
+  // gets out. The gain is computed once per block from the peak of the block and of the lookahead, with a soft knee
+  // above LIMITER_KNEE, ramped over the block and released over LIMITER_RELEASE_MS: channel volumes can then be
+  // set hot, and a loud chord is turned down rather than clipped
+  #define LIMITER_LOOKAHEAD   32        // frames
+  #define LIMITER_KNEE        0x6000    // peaks below this level are not touched
+  #define LIMITER_RELEASE_MS  100       // time for the gain to come back from 0 to unity
+  #define LIMITER_UNITY       0x10000   // gain of 1 (Q16)
+
+  struct Limiter {
+    int32_t   delay[LIMITER_LOOKAHEAD * output_channels] = {};  // mix of the last frames, not output yet
+    uint32_t  delay_peak = 0;         // peak of the delayed frames
+    uint32_t  gain = LIMITER_UNITY;   // gain at the end of the last block (Q16)
+  };
+
+  extern Limiter limiter;
+
+  // renders count frames of a voice and adds them to mix, and to the send mix of the effect bus (count <= SYNTH_BLOCK)
+  typedef void (*voice_kernel)(AudioChannel &channel, int32_t *mix, int32_t *send, uint32_t count);
+
+  // synth engine, specialised at compile time for a number of voices and a set of waveforms:
+  // waveforms outside of WaveformMask are compiled out, and each single waveform
+  // instrument gets its own render loop
+  template <int Voices, uint32_t WaveformMask>
+  struct Synth {
+    static_assert(Voices > 0, "synth needs at least one voice");
+
+    // render count frames of the mix of voices[0 .. Voices-1], through the limiter, into out (count * output_channels samples),
+    // and their send mix into send (count mono samples, not limited; see fx.hpp)
+    static void render(AudioChannel *voices, Limiter &limiter, int16_t *out, int16_t *send, uint32_t count);
+
+    // true if all the waveforms of an instrument are compiled in the engine
+    static constexpr bool supports(uint32_t waveforms) {
+      return (waveforms & ~WaveformMask) == 0;
+    }
+  };
+
+  // the engine of this build
+  typedef Synth<SYNTH_VOICES, SYNTH_WAVEFORMS> Engine;
+
+  // build the one-shots into oneshots (PERCUSSION_FRAMES samples); nothing to build, and oneshots may be nullptr,
+  // if PERCUSSION is not compiled in
+  void init_percussion(int16_t *oneshots);
+  void reset_voices();
+  void render(int16_t *out, int16_t *send, uint32_t count);
   bool is_audio_playing();
 
 }
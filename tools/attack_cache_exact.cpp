@@ -0,0 +1,147 @@
+// host test of the attack cache: the cached attack of a step is the audio the step renders to
+//
+// Plays random steps (waveform, pitch, envelope, volume, pan, send, vibrato, tremolo) over random previous
+// steps, through the attack cache as the firmware does: shadow voices armed from the live ones, cache rendered a
+// block at a time, then played by the audio callback with random buffer sizes. The same shadow voices are also
+// rendered directly, with the same block split. Past the crossfade from the previous step (ATTACK_FADE frames),
+// the output and the send mix must be bit for bit the direct render: from the cache, then from the shadow voices
+// once they have replaced the live voices at the end of the cache.
+// Built for mono and stereo output (SYNTH_STEREO) with ATTACK_CACHE_MS, see CMakeLists.txt in this directory.
+//   attack_cache_exact [steps [seed]]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "attack_cache.hpp"
+
+using namespace synth;
+
+#define EXACT_STEPS         300
+#define EXACT_MAX_FRAMES    300       // frames per audio callback, at most
+#define EXACT_AFTER         2000      // frames checked after the end of the cache
+
+static_assert(ATTACK_CACHE_MS, "the attack cache test needs ATTACK_CACHE_MS");
+
+AudioChannel synth::channels[CHANNEL_COUNT];
+
+// the cache only takes its buffers from the arena, once
+alignas(ARENA_ALIGN) static uint8_t arena[ATTACK_CACHE_ARENA_BYTES];
+static uint32_t arena_used = 0;
+
+void *arena_take(enum arena_owner owner, uint32_t bytes) {
+  (void) owner;
+  void *buffer = &arena[arena_used];
+  arena_used += arena_size(bytes);
+  return buffer;
+}
+
+#define CHECK_FRAMES        (ATTACK_CACHE_FRAMES + EXACT_AFTER)
+
+static int16_t oneshots[PERCUSSION_FRAMES];
+static int16_t out[(CHECK_FRAMES + EXACT_MAX_FRAMES) * output_channels];
+static int16_t send[CHECK_FRAMES + EXACT_MAX_FRAMES];
+static int16_t direct[(CHECK_FRAMES + EXACT_MAX_FRAMES) * output_channels];
+static int16_t direct_send[CHECK_FRAMES + EXACT_MAX_FRAMES];
+static AudioChannel voices[CHANNEL_COUNT];
+
+static uint32_t prng_state = 1;
+
+// xorshift32: the same steps on every host for a given seed
+static uint32_t prng(void) {
+  prng_state ^= prng_state << 13;
+  prng_state ^= prng_state >> 17;
+  prng_state ^= prng_state << 5;
+  return prng_state;
+}
+
+static uint32_t random_in(uint32_t low, uint32_t high) {
+  return low + (prng() % (high - low + 1));
+}
+
+
+// random notes on some of the voices, the others left as they are; no noise, whose generator is shared by all
+// the voices, and so would not give the same samples to the cache and to the direct render
+static void random_step(AudioChannel *step) {
+  static const uint32_t waveforms[] = {Waveform::PIANO, Waveform::PIANO2, Waveform::GUITAR, Waveform::VIOLIN, Waveform::SINE,
+    Waveform::SQUARE, Waveform::PERCUSSION};
+
+  for(int c = 0; c < CHANNEL_COUNT; c++) {
+    if(prng() % 3 == 0) continue;
+    AudioChannel &channel = step[c];
+    uint32_t w = waveforms[prng() % (sizeof(waveforms) / sizeof(waveforms[0]))];
+    channel.waveforms = Engine::supports(w) ? w : uint32_t(Waveform::SINE);
+    channel.frequency = random_in(30, 4000);
+    channel.attack_frames = random_in(1, 2000);
+    channel.decay_frames = random_in(1, 2000);
+    channel.sustain = random_in(0, 0xffff);
+    channel.sustain_frames = random_in(1, 4000);
+    channel.release_frames = random_in(1, 3000);
+    channel.volume = random_in(0, 30000);
+    channel.send = (prng() & 1) ? random_in(0, 0xffff) : 0;
+    channel.filter = (prng() & 1) ? lowpass_coefficient(random_in(200, 8000)) : 0;
+    channel.set_pan(int16_t(random_in(0, 2 * 0x7fff)) - 0x7fff);
+    channel.vibrato_rate = (prng() & 1) ? random_in(1, 0x100000) : 0;
+    channel.vibrato_depth = channel.vibrato_rate ? random_in(1, 0x1000) : 0;
+    channel.tremolo_rate = (prng() & 1) ? random_in(1, 0x100000) : 0;
+    channel.tremolo_depth = channel.tremolo_rate ? random_in(1, 0xffff) : 0;
+    channel.trigger_attack();
+  }
+}
+
+
+int main(int argc, char **argv) {
+  uint32_t steps = (argc > 1) ? strtoul(argv[1], nullptr, 0) : EXACT_STEPS;
+  prng_state = (argc > 2) ? strtoul(argv[2], nullptr, 0) | 1 : 0x2545f491;
+  uint32_t errors = 0, failed = 0;
+
+  init_percussion(oneshots);
+  attack_cache_init();
+  reset_voices();
+  for(uint32_t s = 0; s < steps; s++) {
+    // previous step, still playing when the next one is armed and played
+    random_step(channels);
+    render(out, send, random_in(1, 5000));
+
+    AudioChannel *shadow = attack_cache_arm();
+    random_step(shadow);
+    for(int c = 0; c < CHANNEL_COUNT; c++) voices[c] = shadow[c];
+    while(attack_cache_render()) {}
+    // live voices go on between the end of the render and the pedal
+    render(out, send, random_in(0, 2000));
+    if(!attack_cache_play()) {
+      printf("step %lu: cache not ready\n", (unsigned long) s);
+      return 1;
+    }
+
+    // through the cache, with random buffers, and directly, with the split of the cache then of these buffers
+    Limiter limiter;
+    Engine::render(voices, limiter, direct, direct_send, ATTACK_CACHE_FRAMES);
+    uint32_t frames = 0;
+    while(frames < CHECK_FRAMES) {
+      uint32_t count = random_in(1, EXACT_MAX_FRAMES);
+      attack_cache_audio(&out[frames * output_channels], &send[frames], count);
+      if(frames + count > ATTACK_CACHE_FRAMES) {
+        uint32_t from = (frames > ATTACK_CACHE_FRAMES) ? frames : ATTACK_CACHE_FRAMES;
+        Engine::render(voices, limiter, &direct[from * output_channels], &direct_send[from], frames + count - from);
+      }
+      frames += count;
+    }
+
+    uint32_t step_errors = 0;
+    for(uint32_t i = ATTACK_FADE; i < frames; i++) {
+      for(uint32_t k = i * output_channels; k < (i + 1) * output_channels; k++) {
+        if(out[k] != direct[k]) step_errors++;
+      }
+      if(send[i] != direct_send[i]) step_errors++;
+    }
+    if(step_errors) {
+      failed++;
+      errors += step_errors;
+    }
+  }
+
+  printf("attack cache %s (%d ms): %lu steps, %lu differ from the direct render (%lu samples)\n",
+    (output_channels == 2) ? "stereo" : "mono", ATTACK_CACHE_MS, (unsigned long) steps, (unsigned long) failed,
+    (unsigned long) errors);
+  return errors ? 1 : 0;
+}
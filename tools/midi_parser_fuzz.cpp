@@ -0,0 +1,335 @@
+// host harness of the midi parser: known streams, fuzzing and throughput
+//
+// Built with the host compiler (see CMakeLists.txt in this directory), as the parser has no dependency
+// on the pico SDK. Exits with 1 at the first failure.
+//   - known streams: byte sequences checked against the messages they must give
+//   - structured fuzzing: random messages encoded with and without running status, real-time bytes
+//     inserted anywhere (also in the middle of messages and SysEx), fed in random splits: the parser must
+//     give back the same messages, the real-time bytes at the place they were inserted
+//   - garbage fuzzing: random bytes; the parser state must stay in bounds (data and sysex buffers)
+//   - throughput of a typical stream, in MB/s
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "midi_parser.hpp"
+
+#define FUZZ_STREAMS        20000     // structured streams
+#define FUZZ_MESSAGES       64        // messages per structured stream
+#define GARBAGE_BYTES       (16u << 20)
+#define BENCH_BYTES         (64u << 20)
+
+// a message as given by the parser
+struct parsed {
+  midi_parse_result result;
+  uint8_t status;
+  uint8_t length;
+  uint8_t data[2];
+  std::vector<uint8_t> sysex;
+
+  bool operator==(const parsed &other) const {
+    return (result == other.result) && (status == other.status) && (length == other.length) &&
+      ((length < 1) || (data[0] == other.data[0])) && ((length < 2) || (data[1] == other.data[1])) && (sysex == other.sysex);
+  }
+};
+
+// parser between two guards, to catch writes out of its buffers
+struct guarded_parser {
+  uint32_t before = 0xdeadbeef;
+  struct midi_parser parser;
+  uint32_t after = 0xdeadbeef;
+};
+
+static std::mt19937 rng(0x5eed);
+static uint32_t failures = 0;
+
+
+static uint32_t random_below(uint32_t n) {
+  return rng() % n;
+}
+
+
+static void print_parsed(const char *label, const std::vector<parsed> &messages) {
+  printf("  %s:", label);
+  for(const parsed &m : messages) {
+    if(m.result == MIDI_SYSEX) {
+      printf(" [F0");
+      for(uint8_t b : m.sysex) printf(" %02X", b);
+      printf(" F7]");
+    }
+    else {
+      printf(" [%02X", m.status);
+      for(int i = 0; i < m.length; i++) printf(" %02X", m.data[i]);
+      printf("]");
+    }
+  }
+  printf("\n");
+}
+
+
+static void check_bounds(const struct guarded_parser &g) {
+  const struct midi_parser &p = g.parser;
+  if((g.before != 0xdeadbeef) || (g.after != 0xdeadbeef) || (p.count > 2) || (p.expected > 2) ||
+     (p.sysex_length > MIDI_SYSEX_MAX)) {
+    printf("FAIL: parser state out of bounds (count %u, expected %u, sysex length %u)\n", p.count, p.expected, p.sysex_length);
+    exit(1);
+  }
+}
+
+
+// parse a stream, fed in chunks of random sizes when split is set; the parser state is kept across chunks,
+// as it is across reads of the usb midi stream
+static std::vector<parsed> parse(const std::vector<uint8_t> &stream, bool split) {
+  std::vector<parsed> messages;
+  struct guarded_parser g;
+  struct midi_message msg;
+  size_t pos = 0;
+
+  midi_parser_reset(&g.parser);
+  while(pos < stream.size()) {
+    size_t end = split ? pos + 1 + random_below(16) : stream.size();
+    if(end > stream.size()) end = stream.size();
+    for(; pos < end; pos++) {
+      midi_parse_result result = midi_parse_byte(&g.parser, stream[pos], &msg);
+      check_bounds(g);
+      if(result == MIDI_MESSAGE) {
+        parsed m = {result, msg.status, msg.length, {msg.data[0], msg.data[1]}, {}};
+        messages.push_back(m);
+      }
+      else if(result == MIDI_SYSEX) {
+        parsed m = {result, 0xF0, 0, {0, 0}, std::vector<uint8_t>(g.parser.sysex, g.parser.sysex + g.parser.sysex_length)};
+        messages.push_back(m);
+      }
+    }
+  }
+  return messages;
+}
+
+
+static void expect(const char *name, const std::vector<uint8_t> &stream, const std::vector<parsed> &expected) {
+  std::vector<parsed> messages = parse(stream, false);
+  if(messages == expected) return;
+  printf("FAIL: %s\n", name);
+  print_parsed("expected", expected);
+  print_parsed("parsed", messages);
+  failures++;
+}
+
+
+static parsed message(uint8_t status, uint8_t length = 0, uint8_t data0 = 0, uint8_t data1 = 0) {
+  return {MIDI_MESSAGE, status, length, {data0, data1}, {}};
+}
+
+
+static parsed sysex(std::vector<uint8_t> data) {
+  return {MIDI_SYSEX, 0xF0, 0, {0, 0}, data};
+}
+
+
+static void known_streams(void) {
+  expect("note on", {0x90, 0x3C, 0x40}, {message(0x90, 2, 0x3C, 0x40)});
+  expect("running status", {0x91, 0x3C, 0x40, 0x3E, 0x00, 0x40, 0x7F},
+    {message(0x91, 2, 0x3C, 0x40), message(0x91, 2, 0x3E, 0x00), message(0x91, 2, 0x40, 0x7F)});
+  expect("one data byte messages", {0xC2, 0x05, 0x06, 0xD3, 0x40}, {message(0xC2, 1, 0x05), message(0xC2, 1, 0x06), message(0xD3, 1, 0x40)});
+  expect("real-time in a message", {0x90, 0x3C, 0xF8, 0x40}, {message(0xF8), message(0x90, 2, 0x3C, 0x40)});
+  expect("real-time keeps running status", {0xB0, 0x07, 0x7F, 0xFA, 0x0A, 0x40},
+    {message(0xB0, 2, 0x07, 0x7F), message(0xFA), message(0xB0, 2, 0x0A, 0x40)});
+  expect("data without status", {0x3C, 0x40, 0x80, 0x3C, 0x00}, {message(0x80, 2, 0x3C, 0x00)});
+  expect("sysex", {0xF0, 0x7D, 0x50, 0x02, 0xF7}, {sysex({0x7D, 0x50, 0x02})});
+  expect("real-time in a sysex", {0xF0, 0x7D, 0xF8, 0x50, 0xFE, 0x02, 0xF7}, {message(0xF8), message(0xFE), sysex({0x7D, 0x50, 0x02})});
+  expect("sysex cancels running status", {0x90, 0x3C, 0x40, 0xF0, 0x01, 0xF7, 0x3E, 0x40}, {message(0x90, 2, 0x3C, 0x40), sysex({0x01})});
+  expect("status ends an unterminated sysex", {0xF0, 0x01, 0x02, 0x90, 0x3C, 0x40, 0xF7}, {message(0x90, 2, 0x3C, 0x40)});
+  expect("empty sysex", {0xF0, 0xF7}, {sysex({})});
+  expect("end of sysex alone", {0xF7}, {});
+  expect("song position", {0xF2, 0x10, 0x20}, {message(0xF2, 2, 0x10, 0x20)});
+  expect("system common cancels running status", {0x90, 0x3C, 0x40, 0xF3, 0x01, 0x3E, 0x40},
+    {message(0x90, 2, 0x3C, 0x40), message(0xF3, 1, 0x01)});
+  expect("tune request", {0xF6}, {message(0xF6)});
+  expect("undefined system common", {0xF4, 0x01, 0xF5, 0x02, 0x90, 0x3C, 0x40}, {message(0x90, 2, 0x3C, 0x40)});
+  expect("undefined real-time", {0xF9, 0xFD}, {message(0xF9), message(0xFD)});
+
+  // a SysEx longer than the buffer is truncated, and flagged
+  std::vector<uint8_t> stream = {0xF0};
+  for(int i = 0; i < MIDI_SYSEX_MAX + 10; i++) stream.push_back(i & 0x7F);
+  stream.push_back(0xF7);
+  struct guarded_parser g;
+  struct midi_message msg;
+  midi_parse_result result = MIDI_NONE;
+  midi_parser_reset(&g.parser);
+  for(uint8_t byte : stream) {
+    result = midi_parse_byte(&g.parser, byte, &msg);
+    check_bounds(g);
+  }
+  if((result != MIDI_SYSEX) || !g.parser.sysex_overflow || (g.parser.sysex_length != MIDI_SYSEX_MAX)) {
+    printf("FAIL: long sysex is not truncated\n");
+    failures++;
+  }
+}
+
+
+// random stream of well formed messages, with the messages it must give
+static void random_stream(std::vector<uint8_t> &stream, std::vector<parsed> &expected) {
+  static const uint8_t channel_length[7] = {2, 2, 2, 2, 1, 1, 2};
+  uint8_t running = 0;
+
+  for(int n = 0; n < FUZZ_MESSAGES; n++) {
+    uint32_t kind = random_below(10);
+    if(kind < 7) {
+      // channel message, with running status half of the time it can be used
+      uint8_t status = uint8_t(0x80 | (random_below(7) << 4) | random_below(16));
+      uint8_t length = channel_length[(status >> 4) - 8];
+      uint8_t data0 = uint8_t(random_below(128));
+      uint8_t data1 = uint8_t(random_below(128));
+      if((status != running) || random_below(2)) stream.push_back(status);
+      stream.push_back(data0);
+      if(length == 2) stream.push_back(data1);
+      expected.push_back(message(status, length, data0, data1));
+      running = status;
+    }
+    else if(kind < 9) {
+      // SysEx, up to the size of the buffer
+      std::vector<uint8_t> data(random_below(MIDI_SYSEX_MAX + 1));
+      for(uint8_t &b : data) b = uint8_t(random_below(128));
+      stream.push_back(0xF0);
+      stream.insert(stream.end(), data.begin(), data.end());
+      stream.push_back(0xF7);
+      expected.push_back(sysex(data));
+      running = 0;
+    }
+    else {
+      // system common: song position, song select or tune request
+      static const uint8_t common[3] = {0xF2, 0xF3, 0xF6};
+      uint8_t status = common[random_below(3)];
+      uint8_t length = (status == 0xF2) ? 2 : ((status == 0xF3) ? 1 : 0);
+      uint8_t data0 = uint8_t(random_below(128));
+      uint8_t data1 = uint8_t(random_below(128));
+      stream.push_back(status);
+      if(length > 0) stream.push_back(data0);
+      if(length > 1) stream.push_back(data1);
+      expected.push_back(message(status, length, data0, data1));
+      running = 0;
+    }
+  }
+}
+
+
+// real-time bytes inserted at random places: each one must come out at once, before the message it interrupts
+static void insert_real_time(std::vector<uint8_t> &stream, std::vector<parsed> &expected) {
+  std::vector<uint8_t> with;
+  std::vector<parsed> expected_with;
+  size_t next = 0;            // next expected message, not yet complete in the stream
+  bool in_sysex = false;
+  uint32_t pending = 0;       // data bytes still to come for the current message
+
+  static const uint8_t channel_length[7] = {2, 2, 2, 2, 1, 1, 2};
+  uint8_t running = 0;
+
+  for(uint8_t byte : stream) {
+    if(random_below(8) == 0) {
+      uint8_t real_time = uint8_t(0xF8 + random_below(8));
+      with.push_back(real_time);
+      expected_with.push_back(message(real_time));
+    }
+    with.push_back(byte);
+
+    // follow the message boundaries of the stream, to know when each expected message is complete
+    bool complete = false;
+    if(byte == 0xF0) in_sysex = true;
+    else if(byte == 0xF7) {
+      in_sysex = false;
+      complete = true;
+    }
+    else if(byte >= 0xF0) {
+      running = 0;
+      pending = (byte == 0xF2) ? 2 : ((byte == 0xF3) ? 1 : 0);
+      complete = (pending == 0);
+    }
+    else if(byte >= 0x80) {
+      running = byte;
+      pending = channel_length[(byte >> 4) - 8];
+    }
+    else if(!in_sysex) {
+      if((pending == 0) && running) pending = channel_length[(running >> 4) - 8];
+      complete = (--pending == 0);
+    }
+    if(complete) expected_with.push_back(expected[next++]);
+  }
+  stream.swap(with);
+  expected.swap(expected_with);
+}
+
+
+static void structured_fuzz(void) {
+  for(int s = 0; s < FUZZ_STREAMS; s++) {
+    std::vector<uint8_t> stream;
+    std::vector<parsed> expected;
+    random_stream(stream, expected);
+    insert_real_time(stream, expected);
+    std::vector<parsed> messages = parse(stream, true);
+    if(messages != expected) {
+      printf("FAIL: structured stream %d: %zu messages parsed instead of %zu\n", s, messages.size(), expected.size());
+      failures++;
+      return;
+    }
+  }
+}
+
+
+static void garbage_fuzz(void) {
+  struct guarded_parser g;
+  struct midi_message msg;
+
+  midi_parser_reset(&g.parser);
+  for(uint32_t i = 0; i < GARBAGE_BYTES; i++) {
+    // mostly data bytes, as in real streams, so that messages and SysEx get long enough
+    uint8_t byte = random_below(4) ? uint8_t(random_below(128)) : uint8_t(0x80 + random_below(128));
+    midi_parse_result result = midi_parse_byte(&g.parser, byte, &msg);
+    check_bounds(g);
+    if((result == MIDI_MESSAGE) && (msg.length > 2)) {
+      printf("FAIL: message of %u data bytes\n", msg.length);
+      exit(1);
+    }
+  }
+}
+
+
+// throughput on a stream of notes and controllers with running status, clock bytes and some SysEx
+static void benchmark(void) {
+  std::vector<uint8_t> stream;
+  std::vector<parsed> expected;
+  while(stream.size() < (1u << 16)) random_stream(stream, expected);
+  stream.resize(1u << 16);
+
+  struct midi_parser parser;
+  struct midi_message msg;
+  uint32_t messages = 0;
+  midi_parser_reset(&parser);
+
+  auto start = std::chrono::steady_clock::now();
+  for(uint32_t done = 0; done < BENCH_BYTES; done += stream.size()) {
+    for(uint8_t byte : stream) messages += (midi_parse_byte(&parser, byte, &msg) != MIDI_NONE);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("throughput: %.1f MB/s (%u messages in %u MB)\n", (BENCH_BYTES / 1048576.0) / seconds, messages, BENCH_BYTES >> 20);
+}
+
+
+int main(int argc, char **argv) {
+  (void) argv;
+
+  known_streams();
+  structured_fuzz();
+  garbage_fuzz();
+  if(failures) {
+    printf("%u failures\n", failures);
+    return 1;
+  }
+  printf("midi parser: known streams, %d structured streams and %u MB of garbage OK\n", FUZZ_STREAMS, GARBAGE_BYTES >> 20);
+  // any argument: no benchmark (eg. when run as a test)
+  if(argc < 2) benchmark();
+  return 0;
+}
@@ -0,0 +1,78 @@
+// host benchmark of the synth engine: render time of a buffer with all the voices playing
+//
+// Built once for mono and once for stereo output (SYNTH_STEREO), with the same voices and notes, so that
+// the cost of stereo can be compared, and once per sample rate (see CMakeLists.txt in this directory:
+// "synth_bench" and "synth_rates" targets).
+// Prints the best time of several runs, which is the least disturbed by the host.
+//   synth_bench_mono [blocks [runs]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "synth.hpp"
+
+using namespace synth;
+
+#define BENCH_FRAMES        256       // frames per buffer, as SAMPLES_PER_BUFFER
+#define BENCH_BLOCKS        20000     // buffers per run
+#define BENCH_RUNS          25
+
+AudioChannel synth::channels[CHANNEL_COUNT];
+
+static int16_t oneshots[PERCUSSION_FRAMES];
+static int16_t out[BENCH_FRAMES * output_channels];
+static int16_t send[BENCH_FRAMES];
+
+
+// a mix of the built-in instruments, as a song would use them: pitched voices spread over the stereo field, drums in the centre
+static void start_voices(void) {
+  static const uint32_t waveforms[] = {Waveform::PIANO, Waveform::PIANO2, Waveform::GUITAR, Waveform::REED, Waveform::SQUARE,
+    Waveform::VIOLIN, Waveform::FLUTE, Waveform::HORN, Waveform::PERCUSSION};
+
+  reset_voices();
+  for(int c = 0; c < CHANNEL_COUNT; c++) {
+    AudioChannel &channel = channels[c];
+    uint32_t w = waveforms[c % (sizeof(waveforms) / sizeof(waveforms[0]))];
+    channel.waveforms = Engine::supports(w) ? w : uint32_t(Waveform::SINE);
+    channel.frequency = (w == Waveform::PERCUSSION) ? 500 : 110 + (c * 37);
+    channel.attack_frames = envelope_frames(10);
+    channel.decay_frames = envelope_frames(20);
+    channel.sustain = 0xafff;
+    channel.sustain_frames = envelope_frames(60000);
+    channel.release_frames = envelope_frames(100);
+    channel.volume = 24000;
+    channel.filter = lowpass_coefficient(4000);
+    channel.set_pan(int16_t(-0x7fff + ((2 * 0x7fff * c) / CHANNEL_COUNT)));
+    channel.trigger_attack();
+  }
+}
+
+
+int main(int argc, char **argv) {
+  uint32_t blocks = (argc > 1) ? strtoul(argv[1], nullptr, 0) : BENCH_BLOCKS;
+  uint32_t runs = (argc > 2) ? strtoul(argv[2], nullptr, 0) : BENCH_RUNS;
+  double best = 0;
+  uint32_t check = 0;
+
+  init_percussion(oneshots);
+  for(uint32_t run = 0; run < runs; run++) {
+    start_voices();
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t b = 0; b < blocks; b++) {
+      // drums hit again every 50 buffers, as a beat would
+      if((b % 50) == 0) channels[CHANNEL_COUNT - 1].trigger_attack();
+      render(out, send, BENCH_FRAMES);
+      check += uint16_t(out[b % (BENCH_FRAMES * output_channels)]);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if((run == 0) || (seconds < best)) best = seconds;
+  }
+
+  double frame_ns = (best * 1e9) / (double(blocks) * BENCH_FRAMES);
+  double period_us = (BENCH_FRAMES * 1e6) / sample_rate;
+  printf("synth %s: %d voices at %lu Hz, %.2f ns per frame, %.2f us of %.0f us per buffer of %d frames (%.1f%%, check %08x)\n",
+    (output_channels == 2) ? "stereo" : "mono", CHANNEL_COUNT, (unsigned long) sample_rate, frame_ns,
+    (frame_ns * BENCH_FRAMES) / 1000.0, period_us, BENCH_FRAMES, (frame_ns * BENCH_FRAMES * 0.1) / period_us, check);
+  return 0;
+}
@@ -0,0 +1,93 @@
+// host test of the master limiter: the output peak stays under full scale, for any split of the render calls
+//
+// Plays random chords of all the voices at hot volumes (up to 0xffff, where a single voice reaches full scale), with
+// random attacks, retriggers and releases, through render() with random buffer sizes. No output sample may reach full
+// scale: the limiter must have brought the gain down before every peak, whatever the frames of each call.
+// Built for mono and stereo output (SYNTH_STEREO), see CMakeLists.txt in this directory.
+//   synth_limiter [chords [seed]]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "synth.hpp"
+
+using namespace synth;
+
+#define LIMITER_CHORDS      300
+#define LIMITER_MAX_FRAMES  300       // frames per render() call, at most
+
+AudioChannel synth::channels[CHANNEL_COUNT];
+
+static int16_t oneshots[PERCUSSION_FRAMES];
+static int16_t out[LIMITER_MAX_FRAMES * output_channels];
+static int16_t send[LIMITER_MAX_FRAMES];
+
+static uint32_t prng_state = 1;
+
+// xorshift32: the same chords on every host for a given seed
+static uint32_t prng(void) {
+  prng_state ^= prng_state << 13;
+  prng_state ^= prng_state >> 17;
+  prng_state ^= prng_state << 5;
+  return prng_state;
+}
+
+static uint32_t random_in(uint32_t low, uint32_t high) {
+  return low + (prng() % (high - low + 1));
+}
+
+
+// a loud chord on all the voices: fast attacks, so that the peaks come at once
+static void random_chord(void) {
+  static const uint32_t waveforms[] = {Waveform::PIANO, Waveform::PIANO2, Waveform::GUITAR, Waveform::REED, Waveform::SQUARE,
+    Waveform::SAW, Waveform::SINE, Waveform::PERCUSSION};
+
+  uint32_t base = random_in(40, 400);
+  for(int c = 0; c < CHANNEL_COUNT; c++) {
+    AudioChannel &channel = channels[c];
+    uint32_t w = waveforms[prng() % (sizeof(waveforms) / sizeof(waveforms[0]))];
+    channel.waveforms = Engine::supports(w) ? w : uint32_t(Waveform::SINE);
+    // voices often in unison or an octave apart, whose peaks add up
+    channel.frequency = (prng() & 1) ? base << (prng() % 3) : random_in(40, 4000);
+    channel.attack_frames = random_in(1, 200);
+    channel.decay_frames = random_in(1, 2000);
+    channel.sustain = random_in(0x8000, 0xffff);
+    channel.sustain_frames = random_in(1000, 20000);
+    channel.release_frames = random_in(1, 3000);
+    channel.volume = random_in(20000, 0xffff);
+    channel.set_pan(int16_t(random_in(0, 2 * 0x7fff)) - 0x7fff);
+    channel.trigger_attack();
+  }
+}
+
+
+int main(int argc, char **argv) {
+  uint32_t chords = (argc > 1) ? strtoul(argv[1], nullptr, 0) : LIMITER_CHORDS;
+  prng_state = (argc > 2) ? strtoul(argv[2], nullptr, 0) | 1 : 0x2545f491;
+  uint32_t errors = 0;
+  int32_t peak = 0;
+
+  init_percussion(oneshots);
+  reset_voices();
+  for(uint32_t chord = 0; chord < chords; chord++) {
+    random_chord();
+    uint32_t frames = random_in(500, 8000);
+    for(uint32_t done = 0; done < frames;) {
+      uint32_t count = random_in(1, LIMITER_MAX_FRAMES);
+      // some voices retriggered or released within the chord
+      if(prng() % 8 == 0) channels[prng() % CHANNEL_COUNT].trigger_attack();
+      if(prng() % 8 == 0) channels[prng() % CHANNEL_COUNT].trigger_release();
+      render(out, send, count);
+      for(uint32_t i = 0; i < count * output_channels; i++) {
+        int32_t level = abs(out[i]);
+        if(level > peak) peak = level;
+        if(level >= 0x7fff) errors++;
+      }
+      done += count;
+    }
+  }
+
+  printf("limiter %s: %lu chords, peak %ld of 32767, %lu samples at full scale\n", (output_channels == 2) ? "stereo" : "mono",
+    (unsigned long) chords, (long) peak, (unsigned long) errors);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+// host test of the synth engine: a voice never gets out of its volume
+//
+// Plays random notes (waveform, pitch, envelope, volume, pan, send, tremolo), one at a time, through render()
+// with the limiter and random buffer sizes, down to the end of their release. Each output and send sample must
+// stay within the full scale of the voice scaled by its volume: a gain ramp that goes past its end (eg. below 0
+// at the end of the release, where it would wrap around to full scale) shows as a sample out of these bounds.
+// Built for mono and stereo output (SYNTH_STEREO), see CMakeLists.txt in this directory.
+//   synth_voice_bound [notes [seed]]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "synth.hpp"
+
+using namespace synth;
+
+#define BOUND_NOTES         2000
+#define BOUND_MAX_FRAMES    300       // frames per render() call, at most
+#define BOUND_MARGIN        2         // rounding of the gain ramps, in LSB
+
+AudioChannel synth::channels[CHANNEL_COUNT];
+
+static int16_t out[BOUND_MAX_FRAMES * output_channels];
+static int16_t send[BOUND_MAX_FRAMES];
+
+static uint32_t prng_state = 1;
+
+// xorshift32: the same notes on every host for a given seed
+static uint32_t prng(void) {
+  prng_state ^= prng_state << 13;
+  prng_state ^= prng_state >> 17;
+  prng_state ^= prng_state << 5;
+  return prng_state;
+}
+
+static uint32_t random_in(uint32_t low, uint32_t high) {
+  return low + (prng() % (high - low + 1));
+}
+
+
+// set a random note on the first channel
+static void random_note(AudioChannel &channel) {
+  static const uint32_t waveforms[] = {Waveform::PIANO, Waveform::PIANO, Waveform::PIANO2, Waveform::GUITAR, Waveform::REED,
+    Waveform::SINE, Waveform::SQUARE, Waveform::SAW, Waveform::TRIANGLE};
+
+  channel = AudioChannel();
+  uint32_t w = waveforms[prng() % (sizeof(waveforms) / sizeof(waveforms[0]))];
+  channel.waveforms = Engine::supports(w) ? w : uint32_t(Waveform::SINE);
+  channel.frequency = random_in(30, 4000);
+  channel.attack_frames = random_in(1, 2000);
+  channel.decay_frames = random_in(1, 2000);
+  channel.sustain = random_in(0, 0xffff);
+  channel.sustain_frames = random_in(1, 4000);
+  channel.release_frames = random_in(1, 3000);
+  channel.volume = random_in(0, 0xffff);
+  channel.send = (prng() & 1) ? random_in(0, 0xffff) : 0;
+  channel.set_pan(int16_t(random_in(0, 2 * 0x7fff)) - 0x7fff);
+  if((prng() % 4) == 0) {
+    channel.tremolo_rate = random_in(1, 0x100000);
+    channel.tremolo_depth = random_in(1, 0xffff);
+  }
+}
+
+
+int main(int argc, char **argv) {
+  uint32_t notes = (argc > 1) ? strtoul(argv[1], nullptr, 0) : BOUND_NOTES;
+  prng_state = (argc > 2) ? strtoul(argv[2], nullptr, 0) | 1 : 0x2545f491;
+  uint32_t out_errors = 0, send_errors = 0;
+  int32_t out_worst = 0, send_worst = 0;
+
+  reset_voices();
+  for(uint32_t note = 0; note < notes; note++) {
+    AudioChannel &channel = channels[0];
+    random_note(channel);
+    int32_t voice = (uint32_t(channel.volume) * volume) >> 16;
+    int32_t out_bound = ((0x7fff * voice) >> 16) + BOUND_MARGIN;
+    int32_t send_bound = ((0x7fff * int32_t((uint32_t(voice) * channel.send) >> 16)) >> 16) + BOUND_MARGIN;
+
+    channel.trigger_attack();
+    uint32_t hold = random_in(1, 6000);     // release before or after the end of the sustain
+    uint32_t frames = 0, tail = 0;
+    bool released = false;
+
+    // down to the end of the release, then the lookahead of the limiter, so that no frame of the note is left behind
+    while(tail < 2 * LIMITER_LOOKAHEAD) {
+      uint32_t count = random_in(1, BOUND_MAX_FRAMES);
+      bool release = !released && (frames + count >= hold);
+      if(release) count = (hold > frames) ? hold - frames : 1;
+      if(channel.adsr_phase == ADSRPhase::OFF) tail += count;
+      render(out, send, count);
+      if(release) {
+        channel.trigger_release();
+        released = true;
+      }
+      frames += count;
+
+      for(uint32_t i = 0; i < count * output_channels; i++) {
+        int32_t level = abs(out[i]);
+        if(level > out_bound) {
+          out_errors++;
+          if(level - out_bound > out_worst) out_worst = level - out_bound;
+        }
+      }
+      for(uint32_t i = 0; i < count; i++) {
+        int32_t level = abs(send[i]);
+        if(level > send_bound) {
+          send_errors++;
+          if(level - send_bound > send_worst) send_worst = level - send_bound;
+        }
+      }
+    }
+  }
+
+  printf("synth %s: %lu notes, %lu output samples out of bounds (worst +%ld), %lu send samples out of bounds (worst +%ld)\n",
+    (output_channels == 2) ? "stereo" : "mono", (unsigned long) notes, (unsigned long) out_errors, (long) out_worst,
+    (unsigned long) send_errors, (long) send_worst);
+  return (out_errors || send_errors) ? 1 : 0;
+}
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#include "trace.hpp"
+
+static_assert((TRACE_SIZE & (TRACE_SIZE - 1)) == 0, "trace ring size must be a power of 2");
+static_assert(sizeof(struct trace_record) == 12, "trace record must be 12 bytes");
+
+struct trace_record *trace_ring = nullptr;
+volatile uint32_t trace_head = 0;
+volatile bool trace_frozen = false;
+
+
+// position of the dump in the ring
+static uint32_t dump_next = 0;
+static uint32_t dump_end = 0;
+
+
+void trace_init(void) {
+  trace_ring = (struct trace_record *) arena_take(ARENA_TRACE, TRACE_ARENA_BYTES);
+}
+
+
+void trace_dump_start(void) {
+  // recording is stopped while dumping, so that the ring is not overwritten under our feet
+  trace_frozen = true;
+  dump_end = trace_head;
+  uint32_t count = (dump_end < TRACE_SIZE) ? dump_end : TRACE_SIZE;
+  dump_next = dump_end - count;
+  printf("TRACE %lu\r\n", (unsigned long) count);
+}
+
+
+bool trace_dump_next(void) {
+  if(!trace_frozen) return false;
+  if(dump_next == dump_end) {
+    printf("END\r\n");
+    trace_frozen = false;
+    return false;
+  }
+  const struct trace_record *record = &trace_ring[dump_next++ & (TRACE_SIZE - 1)];
+  printf("%08lx %04x %04x %08lx\r\n", (unsigned long) record->time, record->id, record->arg0, (unsigned long) record->arg1);
+  return true;
+}
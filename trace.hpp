@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "arena.hpp"
+
+// trace ring: compact binary records of firmware events, kept in RAM
+//
+// Recording an event takes a few cycles and never blocks, so it can be used in the audio path,
+// in callbacks and in interrupt handlers. The ring keeps the last TRACE_SIZE events; it is
+// dumped on demand over stdio (see trace_dump_start), and trace_decode.py turns the dump into a timeline.
+// Tracing is compiled in with TRACE_ENABLED (TRACE CMake option); the ring is only taken from the arena then.
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+#define TRACE_SIZE 512            // number of records in the ring; must be a power of 2
+
+// event ids; keep in line with trace_decode.py
+enum trace_id : uint16_t {
+  TRACE_BUFFER_TAKE = 1,          // audio buffer taken for rendering; arg0: frames
+  TRACE_BUFFER_GIVE,              // audio buffer given to i2s; arg0: frames, arg1: render time (us)
+  TRACE_UNDERRUN,                 // all audio buffers were free: i2s ran out of audio; arg1: underruns so far
+  TRACE_MIDI_RX,                  // midi message received; arg0: status, arg1: data bytes
+  TRACE_MIDI_TX,                  // midi data sent; arg0: length, arg1: first 3 bytes
+  TRACE_STEP,                     // next step changed; arg0: song, arg1: step
+  TRACE_VOICE_ON,                 // voice triggered; arg0: channel, arg1: frequency
+  TRACE_VOICE_OFF,                // all voices released
+  TRACE_PEDAL,                    // pedal state changed; arg0: pedal value
+  TRACE_SONG,                     // song loaded; arg0: song, arg1: 1 if switched to a preloaded song
+  TRACE_ERROR,                    // error in song data
+  TRACE_CLOCK,                    // step played on the midi clock; arg0: frame of the audio block, arg1: tempo (0.1 bpm)
+  TRACE_FX,                       // effect bus bypassed; arg0: frames processed within the budget, arg1: cycles
+};
+
+struct trace_record {             // 12 bytes
+  uint32_t time;                  // usec since boot
+  uint16_t id;                    // event id
+  uint16_t arg0;
+  uint32_t arg1;
+};
+
+// RAM of the ring in the arena (see arena.hpp)
+#define TRACE_ARENA_BYTES (TRACE_ENABLED ? TRACE_SIZE * sizeof(struct trace_record) : 0)
+
+extern struct trace_record *trace_ring;
+extern volatile uint32_t trace_head;
+extern volatile bool trace_frozen;
+
+// record an event; interrupts are disabled only to reserve the slot
+static inline void trace_event(uint16_t id, uint16_t arg0, uint32_t arg1) {
+  if(trace_frozen) return;
+  uint32_t interrupts = save_and_disable_interrupts();
+  uint32_t slot = trace_head;
+  trace_head = slot + 1;
+  restore_interrupts(interrupts);
+
+  struct trace_record *record = &trace_ring[slot & (TRACE_SIZE - 1)];
+  record->time = time_us_32();
+  record->id = id;
+  record->arg0 = arg0;
+  record->arg1 = arg1;
+}
+
+// take the ring from the arena; nothing can be recorded before
+void trace_init(void);
+
+// print the records of the ring over stdio, oldest first, as hex lines between "TRACE" and "END"
+// the dump is done one record per call of trace_dump_next(), so that printing does not hold the main loop;
+// recording is stopped until the dump is over
+void trace_dump_start(void);
+bool trace_dump_next(void);       // returns false once the dump is over
+
+#if TRACE_ENABLED
+#define TRACE(id, arg0, arg1) trace_event((id), (arg0), (arg1))
+#else
+#define TRACE(id, arg0, arg1) do {} while(0)
+#endif
@@ -0,0 +1,82 @@
+# TRACE_DECODE : decode a trace dump of Picopanion into a timeline
+#
+# usage : trace_decode.py [log_file]
+#         log_file is a capture of the picopanion serial output, containing the dump printed by the "trace" console command;
+#         reads from standard input if no file is given
+#
+# a trace dump is:
+# TRACE number_of_records
+# time id arg0 arg1			one line per record, oldest first, in hex: time in usec since boot, event id, 2 arguments
+# END
+#
+# output is one line per event: time since first event (ms), time since previous event (ms), event and arguments
+
+
+import sys
+
+
+# event ids, as defined in trace.hpp
+def midiData (arg0, arg1):
+	return 'status %02X data %02X %02X' % (arg0, arg1 & 0xFF, (arg1 >> 8) & 0xFF)
+
+events = {
+	1: ('buffer take', lambda a0, a1: '%d frames' % a0),
+	2: ('buffer give', lambda a0, a1: '%d frames, render %d us' % (a0, a1)),
+	3: ('UNDERRUN', lambda a0, a1: '%d underruns' % a1),
+	4: ('midi rx', midiData),
+	5: ('midi tx', lambda a0, a1: '%d bytes: %02X %02X %02X' % (a0, a1 & 0xFF, (a1 >> 8) & 0xFF, (a1 >> 16) & 0xFF)),
+	6: ('step', lambda a0, a1: 'song %d, next step %d' % (a0, a1)),
+	7: ('voice on', lambda a0, a1: 'channel %d, %d Hz' % (a0, a1)),
+	8: ('voices off', lambda a0, a1: ''),
+	9: ('pedal', lambda a0, a1: 'value %d' % a0),
+	10: ('song', lambda a0, a1: 'song %d%s' % (a0, ' (preloaded)' if a1 else '')),
+	11: ('ERROR', lambda a0, a1: 'song data'),
+	12: ('clock step', lambda a0, a1: 'frame %d, %d.%d bpm' % (a0, a1 // 10, a1 % 10)),
+	13: ('fx bypass', lambda a0, a1: '%d frames in budget, %d cycles' % (a0, a1)),
+}
+
+
+def decode (lines):
+	# keep the records of the last dump of the log
+	last = []
+	records = None
+	for line in lines:
+		line = line.strip ()
+		if line.startswith ('TRACE'):
+			records = []
+		elif line == 'END':
+			if records is not None:
+				last = records
+			records = None
+		elif records is not None:
+			fields = line.split ()
+			if len (fields) == 4:
+				records.append ([int (f, 16) for f in fields])
+	return last
+
+
+def timeline (records):
+	if len (records) == 0:
+		print ('no trace in log')
+		return
+	start = records [0][0]
+	previous = start
+	for time, id, arg0, arg1 in records:
+		# time is a 32-bit usec counter: it wraps every 71 minutes
+		name, args = events.get (id, ('event %d' % id, lambda a0, a1: '%04X %08X' % (a0, a1)))
+		print ('%10.3f %+8.3f  %-12s %s' % (((time - start) & 0xFFFFFFFF) / 1000, ((time - previous) & 0xFFFFFFFF) / 1000, name, args (arg0, arg1)))
+		previous = time
+
+
+######
+# MAIN
+######
+
+if __name__ == '__main__':
+	if len (sys.argv) >= 2:
+		with open (sys.argv [1], 'rt', errors = 'replace') as f:
+			content = f.readlines ()
+		f.close ()
+	else:
+		content = sys.stdin.readlines ()
+	timeline (decode (content))